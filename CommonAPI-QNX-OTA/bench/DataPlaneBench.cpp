@@ -0,0 +1,237 @@
+// Moves a synthetic image over loopback along both transfer paths and
+// compares their throughput. The data plane runs the real DataPlaneServer
+// and DataPlaneClient with 1, 2 and 4 stripes. The event path cannot run
+// without vsomeip, so it is modelled on one TCP connection the way SOME/IP
+// carries it: per chunk a pread, a copy into a message behind a 16-byte
+// SOME/IP header, one send, and on the receiving side a copy out of the
+// message into the chunk buffer. Acks go back every `ack_interval` chunks
+// and the sender keeps at most `window` chunks unacknowledged, as with the
+// default [transfer] settings. Without the routing manager and dispatch
+// threads this is an upper bound for the event path.
+//
+//   dataplane-bench <dir> [megabytes] [chunk KB] [port]   (default 256, 64, 30599)
+//
+// Received bytes land in memory and are compared with the image, so the
+// numbers leave the disk out; writer-bench covers that side.
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "DataPlane.hpp"
+
+#if !defined(MSG_NOSIGNAL)
+#define MSG_NOSIGNAL 0
+#endif
+
+namespace {
+
+const size_t kSomeIpHeader = 16;
+const size_t kChunkFields = 13;  // sessionId, chunkIndex, ByteBuffer length, lastChunk
+const uint32_t kWindow = 32;
+const uint32_t kAckInterval = 8;
+
+bool sendAll(int fd, const uint8_t* data, size_t size) {
+    while (size > 0) {
+        ssize_t n = send(fd, data, size, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        data += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+bool recvAll(int fd, uint8_t* data, size_t size) {
+    while (size > 0) {
+        ssize_t n = recv(fd, data, size, 0);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        data += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+void putU32(uint8_t* p, uint32_t v) { std::memcpy(p, &v, sizeof(v)); }
+
+uint32_t getU32(const uint8_t* p) {
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+// Connected pair of loopback TCP sockets with Nagle off, as vsomeip sets them up
+bool loopbackPair(int& a, int& b) {
+    int listener = socket(AF_INET, SOCK_STREAM, 0);
+    if (listener < 0) return false;
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t len = sizeof(addr);
+    bool ok = bind(listener, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0 && listen(listener, 1) == 0 &&
+              getsockname(listener, reinterpret_cast<sockaddr*>(&addr), &len) == 0;
+    a = ok ? socket(AF_INET, SOCK_STREAM, 0) : -1;
+    ok = ok && a >= 0 && connect(a, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0;
+    b = ok ? accept(listener, nullptr, nullptr) : -1;
+    close(listener);
+    if (!ok || b < 0) {
+        if (a >= 0) close(a);
+        return false;
+    }
+    int one = 1;
+    setsockopt(a, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    setsockopt(b, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    return true;
+}
+
+// sessionChunk events one after the other, paced by the client's acks
+bool eventPath(const std::string& path, uint64_t size, size_t chunk, std::vector<uint8_t>& out) {
+    int serverFd = -1, clientFd = -1;
+    if (!loopbackPair(serverFd, clientFd)) return false;
+    const uint32_t chunkCount = static_cast<uint32_t>((size + chunk - 1) / chunk);
+    std::atomic<uint32_t> acked{0};
+    std::atomic<bool> failed{false};
+
+    std::thread acks([&] {
+        std::vector<uint8_t> msg(kSomeIpHeader + 8);
+        while (acked < chunkCount && recvAll(serverFd, msg.data(), msg.size())) acked = getU32(msg.data() + kSomeIpHeader + 4);
+    });
+
+    std::thread sender([&] {
+        int fd = open(path.c_str(), O_RDONLY);
+        std::vector<uint8_t> buffer(chunk);
+        std::vector<uint8_t> msg(kSomeIpHeader + kChunkFields + chunk);
+        for (uint32_t index = 0; fd >= 0 && index < chunkCount && !failed; ++index) {
+            while (index - acked >= kWindow && !failed) std::this_thread::yield();
+            const size_t want = static_cast<size_t>(std::min<uint64_t>(chunk, size - static_cast<uint64_t>(index) * chunk));
+            if (pread(fd, buffer.data(), want, static_cast<off_t>(index) * chunk) != static_cast<ssize_t>(want)) break;
+            putU32(msg.data() + 4, static_cast<uint32_t>(8 + kChunkFields + want));
+            putU32(msg.data() + kSomeIpHeader, 1);
+            putU32(msg.data() + kSomeIpHeader + 4, index);
+            putU32(msg.data() + kSomeIpHeader + 8, static_cast<uint32_t>(want));
+            std::memcpy(msg.data() + kSomeIpHeader + 12, buffer.data(), want);
+            msg[kSomeIpHeader + 12 + want] = index + 1 == chunkCount;
+            if (!sendAll(serverFd, msg.data(), kSomeIpHeader + kChunkFields + want)) break;
+        }
+        if (fd >= 0) close(fd);
+    });
+
+    std::vector<uint8_t> msg(kSomeIpHeader + kChunkFields + chunk);
+    std::vector<uint8_t> ack(kSomeIpHeader + 8);
+    std::vector<uint8_t> bytes;
+    uint32_t received = 0;
+    while (received < chunkCount) {
+        if (!recvAll(clientFd, msg.data(), kSomeIpHeader)) break;
+        const size_t length = getU32(msg.data() + 4) - 8;
+        if (length < kChunkFields || length > kChunkFields + chunk || !recvAll(clientFd, msg.data() + kSomeIpHeader, length)) break;
+        const uint32_t index = getU32(msg.data() + kSomeIpHeader + 4);
+        const uint32_t n = getU32(msg.data() + kSomeIpHeader + 8);
+        bytes.assign(msg.data() + kSomeIpHeader + 12, msg.data() + kSomeIpHeader + 12 + n);
+        std::memcpy(out.data() + static_cast<uint64_t>(index) * chunk, bytes.data(), bytes.size());
+        ++received;
+        if (received == chunkCount || received % kAckInterval == 0) {
+            putU32(ack.data() + kSomeIpHeader + 4, received);
+            if (!sendAll(clientFd, ack.data(), ack.size())) break;
+        }
+    }
+
+    failed = received < chunkCount;
+    shutdown(clientFd, SHUT_RDWR);
+    shutdown(serverFd, SHUT_RDWR);
+    sender.join();
+    acks.join();
+    close(clientFd);
+    close(serverFd);
+    return received == chunkCount;
+}
+
+bool dataPlane(DataPlaneServer& server, const std::string& path, uint32_t stripes, size_t chunk, std::vector<uint8_t>& out) {
+    const std::string endpoint = server.offer(path, stripes, chunk);
+    return DataPlaneClient::receive(endpoint, stripes, chunk, [&](uint64_t offset, const uint8_t* data, size_t size) {
+        std::memcpy(out.data() + offset, data, size);
+        return true;
+    });
+}
+
+void report(const std::string& name, uint64_t size, double secs, bool ok) {
+    std::cout << std::setw(10) << std::left << name;
+    if (!ok) {
+        std::cout << "failed" << std::endl;
+        return;
+    }
+    std::cout << std::setw(10) << std::right << std::fixed << std::setprecision(1) << (size / (1024.0 * 1024.0)) / secs << " MB/s" << std::endl;
+}
+
+// Runs a transfer with the server's per-stream log lines kept off the report
+double timed(const std::function<bool()>& run, bool& ok) {
+    std::ostringstream quiet;
+    std::streambuf* saved = std::cout.rdbuf(quiet.rdbuf());
+    auto start = std::chrono::steady_clock::now();
+    ok = run();
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout.rdbuf(saved);
+    return secs;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: dataplane-bench <dir> [megabytes] [chunk KB] [port]" << std::endl;
+        return 1;
+    }
+    const std::string path = std::string(argv[1]) + "/dataplane-bench.img";
+    const uint64_t size = ((argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 256) * 1024 * 1024;
+    const size_t chunk = ((argc > 3) ? std::strtoul(argv[3], nullptr, 10) : 64) * 1024;
+    const uint16_t port = static_cast<uint16_t>((argc > 4) ? std::strtoul(argv[4], nullptr, 10) : 30599);
+    if (size == 0 || chunk == 0) return 1;
+
+    std::vector<uint8_t> image(size);
+    for (uint64_t i = 0; i < size; ++i) image[i] = static_cast<uint8_t>((i * 131 + 7) ^ (i >> 16));
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(image.data()), static_cast<std::streamsize>(size));
+        if (!file) {
+            std::cerr << "Cannot write " << path << std::endl;
+            return 1;
+        }
+    }
+
+    DataPlaneServer server("127.0.0.1", port);
+    if (!server.start()) return 1;
+
+    std::cout << (size >> 20) << " MB in " << (chunk >> 10) << " KB chunks over loopback, " << path << std::endl;
+
+    std::vector<uint8_t> out(size);
+    bool ok = false;
+    double secs = timed([&] { return eventPath(path, size, chunk, out); }, ok);
+    report("events", size, secs, ok && out == image);
+
+    for (uint32_t stripes : {1u, 2u, 4u}) {
+        std::fill(out.begin(), out.end(), 0);
+        secs = timed([&] { return dataPlane(server, path, stripes, chunk, out); }, ok);
+        report("tcp x" + std::to_string(stripes), size, secs, ok && out == image);
+    }
+
+    std::cout << "(events: modelled SOME/IP framing, window " << kWindow << ", ack every " << kAckInterval << ")" << std::endl;
+    unlink(path.c_str());
+    return 0;
+}
@@ -0,0 +1,167 @@
+// Writes a synthetic image the way the client receives it and compares the
+// output paths: the std::ofstream loop the client started with, and each
+// ImageWriter backend. Reports throughput including the final flush, how
+// many extents the file ended up in (FIEMAP) and how much of it is still
+// in the page cache (mincore). Run it on the card or device that matters.
+//
+//   writer-bench <dir> [megabytes] [chunk KB] [stripes]   (default 256, 64, 1)
+//
+// With stripes > 1 the image is split into that many contiguous ranges
+// whose pieces are interleaved, as the data plane delivers them.
+
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <linux/fiemap.h>
+#include <linux/fs.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ImageWriter.hpp"
+
+namespace {
+
+// Offsets of the pieces in arrival order
+std::vector<uint64_t> arrivalOrder(uint64_t size, size_t chunk, unsigned stripes) {
+    const uint64_t chunks = (size + chunk - 1) / chunk;
+    const uint64_t perStripe = (chunks + stripes - 1) / stripes;
+
+    std::vector<uint64_t> order;
+    for (uint64_t i = 0; i < perStripe; ++i) {
+        for (unsigned s = 0; s < stripes; ++s) {
+            uint64_t c = s * perStripe + i;
+            if (c < chunks) order.push_back(c * chunk);
+        }
+    }
+    return order;
+}
+
+long extentCount(const std::string& path) {
+#if defined(__linux__) && defined(FS_IOC_FIEMAP)
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return -1;
+    struct fiemap query {};
+    query.fm_length = FIEMAP_MAX_OFFSET;
+    query.fm_flags = FIEMAP_FLAG_SYNC;
+    long n = (ioctl(fd, FS_IOC_FIEMAP, &query) == 0) ? static_cast<long>(query.fm_mapped_extents) : -1;
+    close(fd);
+    return n;
+#else
+    (void)path;
+    return -1;
+#endif
+}
+
+// Percentage of the file's pages resident in the page cache
+double cachedPercent(const std::string& path, uint64_t size) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return -1;
+    void* map = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return -1;
+
+    const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    std::vector<unsigned char> vec((size + page - 1) / page);
+    double percent = -1;
+    if (mincore(map, size, vec.data()) == 0) {
+        size_t resident = 0;
+        for (unsigned char v : vec) resident += v & 1;
+        percent = 100.0 * resident / vec.size();
+    }
+    munmap(map, size);
+    return percent;
+}
+
+void report(const std::string& name, const std::string& path, uint64_t size, double secs, bool ok) {
+    std::cout << std::setw(10) << std::left << name;
+    if (!ok) {
+        std::cout << "failed" << std::endl;
+        return;
+    }
+    std::cout << std::setw(10) << std::right << std::fixed << std::setprecision(1) << (size / (1024.0 * 1024.0)) / secs << " MB/s"
+              << std::setw(8) << extentCount(path) << " extents" << std::setw(8) << cachedPercent(path, size) << "% cached" << std::endl;
+}
+
+double timed(const std::function<bool()>& run, bool& ok) {
+    auto start = std::chrono::steady_clock::now();
+    ok = run();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: writer-bench <dir> [megabytes] [chunk KB] [stripes]" << std::endl;
+        return 1;
+    }
+    const std::string path = std::string(argv[1]) + "/writer-bench.img";
+    const uint64_t size = ((argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 256) * 1024 * 1024;
+    const size_t chunk = ((argc > 3) ? std::strtoul(argv[3], nullptr, 10) : 64) * 1024;
+    const unsigned stripes = (argc > 4) ? static_cast<unsigned>(std::max(1ul, std::strtoul(argv[4], nullptr, 10))) : 1;
+    if (size == 0 || chunk == 0) return 1;
+
+    std::vector<uint8_t> piece(chunk);
+    for (size_t i = 0; i < chunk; ++i) piece[i] = static_cast<uint8_t>(i * 131 + 7);
+    const std::vector<uint64_t> order = arrivalOrder(size, chunk, stripes);
+
+    std::cout << (size >> 20) << " MB in " << (chunk >> 10) << " KB pieces, " << stripes << " stripe(s), " << path << std::endl;
+
+    // Baseline: seek and write through an ofstream, fsync at the end
+    {
+        bool ok = false;
+        double secs = timed(
+            [&] {
+                std::ofstream out(path, std::ios::binary | std::ios::trunc);
+                for (uint64_t offset : order) {
+                    out.seekp(static_cast<std::streamoff>(offset));
+                    out.write(reinterpret_cast<const char*>(piece.data()), static_cast<std::streamsize>(std::min<uint64_t>(chunk, size - offset)));
+                }
+                out.close();
+                int fd = open(path.c_str(), O_RDONLY);
+                bool synced = fd >= 0 && fsync(fd) == 0;
+                if (fd >= 0) close(fd);
+                return out.good() && synced;
+            },
+            ok);
+        report("ofstream", path, size, secs, ok);
+        unlink(path.c_str());
+    }
+
+    bool fellBack = false;
+    for (const char* backend : {"pwrite", "writeback", "direct"}) {
+        std::string used = backend;
+        bool ok = false;
+        double secs = timed(
+            [&] {
+                std::unique_ptr<ImageWriter> writer = ImageWriter::open(path, false, size, backend, 1024 * 1024);
+                if (!writer) return false;
+                used = writer->backendName();
+                for (uint64_t offset : order) {
+                    if (!writer->write(offset, piece.data(), static_cast<size_t>(std::min<uint64_t>(chunk, size - offset)))) return false;
+                }
+                return writer->flush();
+            },
+            ok);
+        fellBack = fellBack || used != backend;
+        report(used == backend ? used : used + "*", path, size, secs, ok);
+        unlink(path.c_str());
+    }
+
+    if (fellBack) std::cout << "(* requested backend unavailable here, fell back)" << std::endl;
+    return 0;
+}
@@ -24,6 +24,7 @@
 #include <CommonAPI/Struct.hpp>
 #include <CommonAPI/Types.hpp>
 #include <cstdint>
+#include <string>
 
 #if defined (HAS_DEFINED_COMMONAPI_INTERNAL_COMPILATION_HERE)
 #undef COMMONAPI_INTERNAL_COMPILATION
@@ -80,6 +81,82 @@ public:
         }
     
     };
+    struct TransferRequest : CommonAPI::Struct< bool, std::string, uint8_t, std::string, uint32_t, uint64_t, uint64_t> {
+    
+        TransferRequest()
+        {
+            std::get< 0>(values_) = false;
+            std::get< 1>(values_) = "";
+            std::get< 2>(values_) = 0u;
+            std::get< 3>(values_) = "";
+            std::get< 4>(values_) = 0ul;
+            std::get< 5>(values_) = 0ull;
+            std::get< 6>(values_) = 0ull;
+        }
+        TransferRequest(const bool &_dataPlane, const std::string &_hostId, const uint8_t &_stripes, const std::string &_clientId, const uint32_t &_receiveBuffer, const uint64_t &_resumeOffset, const uint64_t &_rangeEnd)
+        {
+            std::get< 0>(values_) = _dataPlane;
+            std::get< 1>(values_) = _hostId;
+            std::get< 2>(values_) = _stripes;
+            std::get< 3>(values_) = _clientId;
+            std::get< 4>(values_) = _receiveBuffer;
+            std::get< 5>(values_) = _resumeOffset;
+            std::get< 6>(values_) = _rangeEnd;
+        }
+        inline const bool &getDataPlane() const { return std::get< 0>(values_); }
+        inline void setDataPlane(const bool _value) { std::get< 0>(values_) = _value; }
+        inline const std::string &getHostId() const { return std::get< 1>(values_); }
+        inline void setHostId(const std::string &_value) { std::get< 1>(values_) = _value; }
+        inline const uint8_t &getStripes() const { return std::get< 2>(values_); }
+        inline void setStripes(const uint8_t &_value) { std::get< 2>(values_) = _value; }
+        inline const std::string &getClientId() const { return std::get< 3>(values_); }
+        inline void setClientId(const std::string &_value) { std::get< 3>(values_) = _value; }
+        inline const uint32_t &getReceiveBuffer() const { return std::get< 4>(values_); }
+        inline void setReceiveBuffer(const uint32_t &_value) { std::get< 4>(values_) = _value; }
+        inline const uint64_t &getResumeOffset() const { return std::get< 5>(values_); }
+        inline void setResumeOffset(const uint64_t &_value) { std::get< 5>(values_) = _value; }
+        inline const uint64_t &getRangeEnd() const { return std::get< 6>(values_); }
+        inline void setRangeEnd(const uint64_t &_value) { std::get< 6>(values_) = _value; }
+        inline bool operator==(const TransferRequest& _other) const {
+        return (getDataPlane() == _other.getDataPlane() && getHostId() == _other.getHostId() && getStripes() == _other.getStripes() && getClientId() == _other.getClientId() && getReceiveBuffer() == _other.getReceiveBuffer() && getResumeOffset() == _other.getResumeOffset() && getRangeEnd() == _other.getRangeEnd());
+        }
+        inline bool operator!=(const TransferRequest &_other) const {
+            return !((*this) == _other);
+        }
+    
+    };
+    struct TransferSession : CommonAPI::Struct< std::string, uint8_t, uint32_t, uint32_t> {
+    
+        TransferSession()
+        {
+            std::get< 0>(values_) = "";
+            std::get< 1>(values_) = 0u;
+            std::get< 2>(values_) = 0u;
+            std::get< 3>(values_) = 0u;
+        }
+        TransferSession(const std::string &_dataEndpoint, const uint8_t &_stripes, const uint32_t &_sessionId, const uint32_t &_chunkSize)
+        {
+            std::get< 0>(values_) = _dataEndpoint;
+            std::get< 1>(values_) = _stripes;
+            std::get< 2>(values_) = _sessionId;
+            std::get< 3>(values_) = _chunkSize;
+        }
+        inline const std::string &getDataEndpoint() const { return std::get< 0>(values_); }
+        inline void setDataEndpoint(const std::string &_value) { std::get< 0>(values_) = _value; }
+        inline const uint8_t &getStripes() const { return std::get< 1>(values_); }
+        inline void setStripes(const uint8_t &_value) { std::get< 1>(values_) = _value; }
+        inline const uint32_t &getSessionId() const { return std::get< 2>(values_); }
+        inline void setSessionId(const uint32_t &_value) { std::get< 2>(values_) = _value; }
+        inline const uint32_t &getChunkSize() const { return std::get< 3>(values_); }
+        inline void setChunkSize(const uint32_t &_value) { std::get< 3>(values_) = _value; }
+        inline bool operator==(const TransferSession& _other) const {
+        return (getDataEndpoint() == _other.getDataEndpoint() && getStripes() == _other.getStripes() && getSessionId() == _other.getSessionId() && getChunkSize() == _other.getChunkSize());
+        }
+        inline bool operator!=(const TransferSession &_other) const {
+            return !((*this) == _other);
+        }
+    
+    };
 };
 
 const char* FileTransfer::getInterface() {
@@ -111,12 +111,102 @@ public:
      * It will provide the same value for CallStatus as will be handed to the callback.
      */
     virtual std::future<CommonAPI::CallStatus> startTransferAsync(const std::string &_fileName, StartTransferAsyncCallback _callback = nullptr, const CommonAPI::CallInfo *_info = nullptr);
+    /**
+     * Calls ackChunks with synchronous semantics.
+     *
+     * All const parameters are input parameters to this method.
+     * All non-const parameters will be filled with the returned values.
+     * The CallStatus will be filled when the method returns and indicate either
+     * "SUCCESS" or which type of error has occurred. In case of an error, ONLY the CallStatus
+     * will be set.
+     */
+    virtual void ackChunks(uint32_t _sessionId, uint32_t _nextChunk, CommonAPI::CallStatus &_internalCallStatus, bool &_known, const CommonAPI::CallInfo *_info = nullptr);
+    /**
+     * Calls ackChunks with asynchronous semantics.
+     *
+     * The provided callback will be called when the reply to this call arrives or
+     * an error occurs during the call. The CallStatus will indicate either "SUCCESS"
+     * or which type of error has occurred. In case of any error, ONLY the CallStatus
+     * will have a defined value.
+     * The std::future returned by this method will be fulfilled at arrival of the reply.
+     * It will provide the same value for CallStatus as will be handed to the callback.
+     */
+    virtual std::future<CommonAPI::CallStatus> ackChunksAsync(const uint32_t &_sessionId, const uint32_t &_nextChunk, AckChunksAsyncCallback _callback = nullptr, const CommonAPI::CallInfo *_info = nullptr);
+    /**
+     * Calls reportVerification with synchronous semantics.
+     *
+     * All const parameters are input parameters to this method.
+     * All non-const parameters will be filled with the returned values.
+     * The CallStatus will be filled when the method returns and indicate either
+     * "SUCCESS" or which type of error has occurred. In case of an error, ONLY the CallStatus
+     * will be set.
+     */
+    virtual void reportVerification(uint32_t _sessionId, bool _verified, uint32_t _crc, std::string _sha256, CommonAPI::CallStatus &_internalCallStatus, bool &_known, const CommonAPI::CallInfo *_info = nullptr);
+    /**
+     * Calls reportVerification with asynchronous semantics.
+     *
+     * The provided callback will be called when the reply to this call arrives or
+     * an error occurs during the call. The CallStatus will indicate either "SUCCESS"
+     * or which type of error has occurred. In case of any error, ONLY the CallStatus
+     * will have a defined value.
+     * The std::future returned by this method will be fulfilled at arrival of the reply.
+     * It will provide the same value for CallStatus as will be handed to the callback.
+     */
+    virtual std::future<CommonAPI::CallStatus> reportVerificationAsync(const uint32_t &_sessionId, const bool &_verified, const uint32_t &_crc, const std::string &_sha256, ReportVerificationAsyncCallback _callback = nullptr, const CommonAPI::CallInfo *_info = nullptr);
+    /**
+     * Calls checkUpdate with synchronous semantics.
+     *
+     * All const parameters are input parameters to this method.
+     * All non-const parameters will be filled with the returned values.
+     * The CallStatus will be filled when the method returns and indicate either
+     * "SUCCESS" or which type of error has occurred. In case of an error, ONLY the CallStatus
+     * will be set.
+     */
+    virtual void checkUpdate(uint32_t _currentVersion, CommonAPI::CallStatus &_internalCallStatus, FileTransfer::UpdateInfo &_info_, std::string &_sha256, const CommonAPI::CallInfo *_info = nullptr);
+    /**
+     * Calls checkUpdate with asynchronous semantics.
+     *
+     * The provided callback will be called when the reply to this call arrives or
+     * an error occurs during the call. The CallStatus will indicate either "SUCCESS"
+     * or which type of error has occurred. In case of any error, ONLY the CallStatus
+     * will have a defined value.
+     * The std::future returned by this method will be fulfilled at arrival of the reply.
+     * It will provide the same value for CallStatus as will be handed to the callback.
+     */
+    virtual std::future<CommonAPI::CallStatus> checkUpdateAsync(const uint32_t &_currentVersion, CheckUpdateAsyncCallback _callback = nullptr, const CommonAPI::CallInfo *_info = nullptr);
+    /**
+     * Calls startSession with synchronous semantics.
+     *
+     * All const parameters are input parameters to this method.
+     * All non-const parameters will be filled with the returned values.
+     * The CallStatus will be filled when the method returns and indicate either
+     * "SUCCESS" or which type of error has occurred. In case of an error, ONLY the CallStatus
+     * will be set.
+     */
+    virtual void startSession(std::string _fileName, FileTransfer::TransferRequest _request, CommonAPI::CallStatus &_internalCallStatus, bool &_accepted, FileTransfer::TransferSession &_session, const CommonAPI::CallInfo *_info = nullptr);
+    /**
+     * Calls startSession with asynchronous semantics.
+     *
+     * The provided callback will be called when the reply to this call arrives or
+     * an error occurs during the call. The CallStatus will indicate either "SUCCESS"
+     * or which type of error has occurred. In case of any error, ONLY the CallStatus
+     * will have a defined value.
+     * The std::future returned by this method will be fulfilled at arrival of the reply.
+     * It will provide the same value for CallStatus as will be handed to the callback.
+     */
+    virtual std::future<CommonAPI::CallStatus> startSessionAsync(const std::string &_fileName, const FileTransfer::TransferRequest &_request, StartSessionAsyncCallback _callback = nullptr, const CommonAPI::CallInfo *_info = nullptr);
     /**
      * Returns the wrapper class that provides access to the broadcast fileChunk.
      */
     virtual FileChunkEvent& getFileChunkEvent() {
         return delegate_->getFileChunkEvent();
     }
+    /**
+     * Returns the wrapper class that provides access to the broadcast sessionChunk.
+     */
+    virtual SessionChunkEvent& getSessionChunkEvent() {
+        return delegate_->getSessionChunkEvent();
+    }
 
 
 
@@ -158,6 +248,45 @@ template <typename ... _AttributeExtensions>
 std::future<CommonAPI::CallStatus> FileTransferProxy<_AttributeExtensions...>::startTransferAsync(const std::string &_fileName, StartTransferAsyncCallback _callback, const CommonAPI::CallInfo *_info) {
     return delegate_->startTransferAsync(_fileName, _callback, _info);
 }
+template <typename ... _AttributeExtensions>
+void FileTransferProxy<_AttributeExtensions...>::ackChunks(uint32_t _sessionId, uint32_t _nextChunk, CommonAPI::CallStatus &_internalCallStatus, bool &_known, const CommonAPI::CallInfo *_info) {
+    delegate_->ackChunks(_sessionId, _nextChunk, _internalCallStatus, _known, _info);
+}
+
+template <typename ... _AttributeExtensions>
+std::future<CommonAPI::CallStatus> FileTransferProxy<_AttributeExtensions...>::ackChunksAsync(const uint32_t &_sessionId, const uint32_t &_nextChunk, AckChunksAsyncCallback _callback, const CommonAPI::CallInfo *_info) {
+    return delegate_->ackChunksAsync(_sessionId, _nextChunk, _callback, _info);
+}
+
+template <typename ... _AttributeExtensions>
+void FileTransferProxy<_AttributeExtensions...>::reportVerification(uint32_t _sessionId, bool _verified, uint32_t _crc, std::string _sha256, CommonAPI::CallStatus &_internalCallStatus, bool &_known, const CommonAPI::CallInfo *_info) {
+    delegate_->reportVerification(_sessionId, _verified, _crc, _sha256, _internalCallStatus, _known, _info);
+}
+
+template <typename ... _AttributeExtensions>
+std::future<CommonAPI::CallStatus> FileTransferProxy<_AttributeExtensions...>::reportVerificationAsync(const uint32_t &_sessionId, const bool &_verified, const uint32_t &_crc, const std::string &_sha256, ReportVerificationAsyncCallback _callback, const CommonAPI::CallInfo *_info) {
+    return delegate_->reportVerificationAsync(_sessionId, _verified, _crc, _sha256, _callback, _info);
+}
+
+template <typename ... _AttributeExtensions>
+void FileTransferProxy<_AttributeExtensions...>::checkUpdate(uint32_t _currentVersion, CommonAPI::CallStatus &_internalCallStatus, FileTransfer::UpdateInfo &_info_, std::string &_sha256, const CommonAPI::CallInfo *_info) {
+    delegate_->checkUpdate(_currentVersion, _internalCallStatus, _info_, _sha256, _info);
+}
+
+template <typename ... _AttributeExtensions>
+std::future<CommonAPI::CallStatus> FileTransferProxy<_AttributeExtensions...>::checkUpdateAsync(const uint32_t &_currentVersion, CheckUpdateAsyncCallback _callback, const CommonAPI::CallInfo *_info) {
+    return delegate_->checkUpdateAsync(_currentVersion, _callback, _info);
+}
+
+template <typename ... _AttributeExtensions>
+void FileTransferProxy<_AttributeExtensions...>::startSession(std::string _fileName, FileTransfer::TransferRequest _request, CommonAPI::CallStatus &_internalCallStatus, bool &_accepted, FileTransfer::TransferSession &_session, const CommonAPI::CallInfo *_info) {
+    delegate_->startSession(_fileName, _request, _internalCallStatus, _accepted, _session, _info);
+}
+
+template <typename ... _AttributeExtensions>
+std::future<CommonAPI::CallStatus> FileTransferProxy<_AttributeExtensions...>::startSessionAsync(const std::string &_fileName, const FileTransfer::TransferRequest &_request, StartSessionAsyncCallback _callback, const CommonAPI::CallInfo *_info) {
+    return delegate_->startSessionAsync(_fileName, _request, _callback, _info);
+}
 
 template <typename ... _AttributeExtensions>
 const CommonAPI::Address &FileTransferProxy<_AttributeExtensions...>::getAddress() const {
@@ -46,15 +46,31 @@ public:
     typedef CommonAPI::Event<
         uint32_t, CommonAPI::ByteBuffer, bool
     > FileChunkEvent;
+    typedef CommonAPI::Event<
+        uint32_t, uint32_t, CommonAPI::ByteBuffer, bool
+    > SessionChunkEvent;
 
     typedef std::function<void(const CommonAPI::CallStatus&, const FileTransfer::UpdateInfo&)> RequestUpdateAsyncCallback;
     typedef std::function<void(const CommonAPI::CallStatus&, const bool&)> StartTransferAsyncCallback;
+    typedef std::function<void(const CommonAPI::CallStatus&, const bool&)> AckChunksAsyncCallback;
+    typedef std::function<void(const CommonAPI::CallStatus&, const bool&)> ReportVerificationAsyncCallback;
+    typedef std::function<void(const CommonAPI::CallStatus&, const FileTransfer::UpdateInfo&, const std::string&)> CheckUpdateAsyncCallback;
+    typedef std::function<void(const CommonAPI::CallStatus&, const bool&, const FileTransfer::TransferSession&)> StartSessionAsyncCallback;
 
     virtual void requestUpdate(uint32_t _currentVersion, CommonAPI::CallStatus &_internalCallStatus, FileTransfer::UpdateInfo &_info_, const CommonAPI::CallInfo *_info = nullptr) = 0;
     virtual std::future<CommonAPI::CallStatus> requestUpdateAsync(const uint32_t &_currentVersion, RequestUpdateAsyncCallback _callback = nullptr, const CommonAPI::CallInfo *_info = nullptr) = 0;
     virtual void startTransfer(std::string _fileName, CommonAPI::CallStatus &_internalCallStatus, bool &_accepted, const CommonAPI::CallInfo *_info = nullptr) = 0;
     virtual std::future<CommonAPI::CallStatus> startTransferAsync(const std::string &_fileName, StartTransferAsyncCallback _callback = nullptr, const CommonAPI::CallInfo *_info = nullptr) = 0;
+    virtual void ackChunks(uint32_t _sessionId, uint32_t _nextChunk, CommonAPI::CallStatus &_internalCallStatus, bool &_known, const CommonAPI::CallInfo *_info = nullptr) = 0;
+    virtual std::future<CommonAPI::CallStatus> ackChunksAsync(const uint32_t &_sessionId, const uint32_t &_nextChunk, AckChunksAsyncCallback _callback = nullptr, const CommonAPI::CallInfo *_info = nullptr) = 0;
+    virtual void reportVerification(uint32_t _sessionId, bool _verified, uint32_t _crc, std::string _sha256, CommonAPI::CallStatus &_internalCallStatus, bool &_known, const CommonAPI::CallInfo *_info = nullptr) = 0;
+    virtual std::future<CommonAPI::CallStatus> reportVerificationAsync(const uint32_t &_sessionId, const bool &_verified, const uint32_t &_crc, const std::string &_sha256, ReportVerificationAsyncCallback _callback = nullptr, const CommonAPI::CallInfo *_info = nullptr) = 0;
+    virtual void checkUpdate(uint32_t _currentVersion, CommonAPI::CallStatus &_internalCallStatus, FileTransfer::UpdateInfo &_info_, std::string &_sha256, const CommonAPI::CallInfo *_info = nullptr) = 0;
+    virtual std::future<CommonAPI::CallStatus> checkUpdateAsync(const uint32_t &_currentVersion, CheckUpdateAsyncCallback _callback = nullptr, const CommonAPI::CallInfo *_info = nullptr) = 0;
+    virtual void startSession(std::string _fileName, FileTransfer::TransferRequest _request, CommonAPI::CallStatus &_internalCallStatus, bool &_accepted, FileTransfer::TransferSession &_session, const CommonAPI::CallInfo *_info = nullptr) = 0;
+    virtual std::future<CommonAPI::CallStatus> startSessionAsync(const std::string &_fileName, const FileTransfer::TransferRequest &_request, StartSessionAsyncCallback _callback = nullptr, const CommonAPI::CallInfo *_info = nullptr) = 0;
     virtual FileChunkEvent& getFileChunkEvent() = 0;
+    virtual SessionChunkEvent& getSessionChunkEvent() = 0;
 
     virtual std::future<void> getCompletionFuture() = 0;
 };
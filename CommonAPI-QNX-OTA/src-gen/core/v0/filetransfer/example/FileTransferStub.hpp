@@ -58,6 +58,11 @@ class FileTransferStubAdapter
     * Instead, the "fire<broadcastName>Event" methods of the stub should be used.
     */
     virtual void fireFileChunkEvent(const uint32_t &_chunkIndex, const CommonAPI::ByteBuffer &_data, const bool &_lastChunk) = 0;
+    /**
+    * Sends a broadcast event for sessionChunk. Should not be called directly.
+    * Instead, the "fire<broadcastName>Event" methods of the stub should be used.
+    */
+    virtual void fireSessionChunkEvent(const uint32_t &_sessionId, const uint32_t &_chunkIndex, const CommonAPI::ByteBuffer &_data, const bool &_lastChunk) = 0;
 
 
     virtual void deactivateManagedInstances() = 0;
@@ -102,11 +107,15 @@ class FileTransferStub
 public:
     typedef std::function<void (FileTransfer::UpdateInfo _info_)> requestUpdateReply_t;
     typedef std::function<void (bool _accepted)> startTransferReply_t;
+    typedef std::function<void (bool _known)> ackChunksReply_t;
+    typedef std::function<void (bool _known)> reportVerificationReply_t;
+    typedef std::function<void (FileTransfer::UpdateInfo _info_, std::string _sha256)> checkUpdateReply_t;
+    typedef std::function<void (bool _accepted, FileTransfer::TransferSession _session)> startSessionReply_t;
 
     virtual ~FileTransferStub() {}
     void lockInterfaceVersionAttribute(bool _lockAccess) { static_cast<void>(_lockAccess); }
     bool hasElement(const uint32_t _id) const {
-        return (_id < 3);
+        return (_id < 8);
     }
     virtual const CommonAPI::Version& getInterfaceVersion(std::shared_ptr<CommonAPI::ClientId> _client) = 0;
 
@@ -114,12 +123,26 @@ public:
     virtual void requestUpdate(const std::shared_ptr<CommonAPI::ClientId> _client, uint32_t _currentVersion, requestUpdateReply_t _reply) = 0;
     /// This is the method that will be called on remote calls on the method startTransfer.
     virtual void startTransfer(const std::shared_ptr<CommonAPI::ClientId> _client, std::string _fileName, startTransferReply_t _reply) = 0;
+    /// This is the method that will be called on remote calls on the method ackChunks.
+    virtual void ackChunks(const std::shared_ptr<CommonAPI::ClientId> _client, uint32_t _sessionId, uint32_t _nextChunk, ackChunksReply_t _reply) = 0;
+    /// This is the method that will be called on remote calls on the method reportVerification.
+    virtual void reportVerification(const std::shared_ptr<CommonAPI::ClientId> _client, uint32_t _sessionId, bool _verified, uint32_t _crc, std::string _sha256, reportVerificationReply_t _reply) = 0;
+    /// This is the method that will be called on remote calls on the method checkUpdate.
+    virtual void checkUpdate(const std::shared_ptr<CommonAPI::ClientId> _client, uint32_t _currentVersion, checkUpdateReply_t _reply) = 0;
+    /// This is the method that will be called on remote calls on the method startSession.
+    virtual void startSession(const std::shared_ptr<CommonAPI::ClientId> _client, std::string _fileName, FileTransfer::TransferRequest _request, startSessionReply_t _reply) = 0;
     /// Sends a broadcast event for fileChunk.
     virtual void fireFileChunkEvent(const uint32_t &_chunkIndex, const CommonAPI::ByteBuffer &_data, const bool &_lastChunk) {
         auto stubAdapter = CommonAPI::Stub<FileTransferStubAdapter, FileTransferStubRemoteEvent>::stubAdapter_.lock();
         if (stubAdapter)
             stubAdapter->fireFileChunkEvent(_chunkIndex, _data, _lastChunk);
     }
+    /// Sends a broadcast event for sessionChunk.
+    virtual void fireSessionChunkEvent(const uint32_t &_sessionId, const uint32_t &_chunkIndex, const CommonAPI::ByteBuffer &_data, const bool &_lastChunk) {
+        auto stubAdapter = CommonAPI::Stub<FileTransferStubAdapter, FileTransferStubRemoteEvent>::stubAdapter_.lock();
+        if (stubAdapter)
+            stubAdapter->fireSessionChunkEvent(_sessionId, _chunkIndex, _data, _lastChunk);
+    }
 
 
     using CommonAPI::Stub<FileTransferStubAdapter, FileTransferStubRemoteEvent>::initStubAdapter;
@@ -73,9 +73,43 @@ public:
         bool accepted = false;
         _reply(accepted);
     }
+    COMMONAPI_EXPORT virtual void ackChunks(const std::shared_ptr<CommonAPI::ClientId> _client, uint32_t _sessionId, uint32_t _nextChunk, ackChunksReply_t _reply) {
+        (void)_client;
+        (void)_sessionId;
+        (void)_nextChunk;
+        bool known = false;
+        _reply(known);
+    }
+    COMMONAPI_EXPORT virtual void reportVerification(const std::shared_ptr<CommonAPI::ClientId> _client, uint32_t _sessionId, bool _verified, uint32_t _crc, std::string _sha256, reportVerificationReply_t _reply) {
+        (void)_client;
+        (void)_sessionId;
+        (void)_verified;
+        (void)_crc;
+        (void)_sha256;
+        bool known = false;
+        _reply(known);
+    }
+    COMMONAPI_EXPORT virtual void checkUpdate(const std::shared_ptr<CommonAPI::ClientId> _client, uint32_t _currentVersion, checkUpdateReply_t _reply) {
+        (void)_client;
+        (void)_currentVersion;
+        FileTransfer::UpdateInfo info_ = {};
+        std::string sha256 = "";
+        _reply(info_, sha256);
+    }
+    COMMONAPI_EXPORT virtual void startSession(const std::shared_ptr<CommonAPI::ClientId> _client, std::string _fileName, FileTransfer::TransferRequest _request, startSessionReply_t _reply) {
+        (void)_client;
+        (void)_fileName;
+        (void)_request;
+        bool accepted = false;
+        FileTransfer::TransferSession session = {};
+        _reply(accepted, session);
+    }
     COMMONAPI_EXPORT virtual void fireFileChunkEvent(const uint32_t &_chunkIndex, const CommonAPI::ByteBuffer &_data, const bool &_lastChunk) {
         FileTransferStub::fireFileChunkEvent(_chunkIndex, _data, _lastChunk);
     }
+    COMMONAPI_EXPORT virtual void fireSessionChunkEvent(const uint32_t &_sessionId, const uint32_t &_chunkIndex, const CommonAPI::ByteBuffer &_data, const bool &_lastChunk) {
+        FileTransferStub::fireSessionChunkEvent(_sessionId, _chunkIndex, _data, _lastChunk);
+    }
 
 
 protected:
@@ -37,6 +37,23 @@ typedef CommonAPI::SomeIP::StructDeployment<
     CommonAPI::SomeIP::IntegerDeployment<int32_t>
 > UpdateInfoDeployment_t;
 
+typedef CommonAPI::SomeIP::StructDeployment<
+    CommonAPI::EmptyDeployment,
+    CommonAPI::SomeIP::StringDeployment,
+    CommonAPI::SomeIP::IntegerDeployment<uint8_t>,
+    CommonAPI::SomeIP::StringDeployment,
+    CommonAPI::SomeIP::IntegerDeployment<uint32_t>,
+    CommonAPI::SomeIP::IntegerDeployment<uint64_t>,
+    CommonAPI::SomeIP::IntegerDeployment<uint64_t>
+> TransferRequestDeployment_t;
+
+typedef CommonAPI::SomeIP::StructDeployment<
+    CommonAPI::SomeIP::StringDeployment,
+    CommonAPI::SomeIP::IntegerDeployment<uint8_t>,
+    CommonAPI::SomeIP::IntegerDeployment<uint32_t>,
+    CommonAPI::SomeIP::IntegerDeployment<uint32_t>
+> TransferSessionDeployment_t;
+
 // Type-specific deployments
 
 // Attribute-specific deployments
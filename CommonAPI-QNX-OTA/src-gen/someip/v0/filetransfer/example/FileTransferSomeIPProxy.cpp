@@ -35,6 +35,9 @@ void initializeFileTransferSomeIPProxy() {
     CommonAPI::SomeIP::AddressTranslator::get()->insert(
         "local:filetransfer.example.FileTransfer:v0_1:filetransfer.example.FileTransfer",
         0x6000, 0x7000, 0, 1);
+    CommonAPI::SomeIP::AddressTranslator::get()->insert(
+        "local:filetransfer.example.FileTransfer:v0_1:filetransfer.example.FileTransferPeer",
+        0x6000, 0x7001, 0, 1);
     CommonAPI::SomeIP::Factory::get()->registerProxyCreateMethod(
         "filetransfer.example.FileTransfer:v0_1",
         &createFileTransferSomeIPProxy);
@@ -48,7 +51,8 @@ FileTransferSomeIPProxy::FileTransferSomeIPProxy(
     const CommonAPI::SomeIP::Address &_address,
     const std::shared_ptr<CommonAPI::SomeIP::ProxyConnection> &_connection)
         : CommonAPI::SomeIP::Proxy(_address, _connection),
-          fileChunk_(*this, 0x2000, CommonAPI::SomeIP::event_id_t(0x8020), CommonAPI::SomeIP::event_type_e::ET_EVENT , CommonAPI::SomeIP::reliability_type_e::RT_RELIABLE, false, std::make_tuple(static_cast< CommonAPI::SomeIP::IntegerDeployment<uint32_t>* >(nullptr), static_cast< CommonAPI::SomeIP::ByteBufferDeployment* >(nullptr), static_cast< CommonAPI::EmptyDeployment* >(nullptr)))
+          fileChunk_(*this, 0x2000, CommonAPI::SomeIP::event_id_t(0x8020), CommonAPI::SomeIP::event_type_e::ET_EVENT , CommonAPI::SomeIP::reliability_type_e::RT_RELIABLE, false, std::make_tuple(static_cast< CommonAPI::SomeIP::IntegerDeployment<uint32_t>* >(nullptr), static_cast< CommonAPI::SomeIP::ByteBufferDeployment* >(nullptr), static_cast< CommonAPI::EmptyDeployment* >(nullptr))),
+          sessionChunk_(*this, 0x2001, CommonAPI::SomeIP::event_id_t(0x8021), CommonAPI::SomeIP::event_type_e::ET_EVENT , CommonAPI::SomeIP::reliability_type_e::RT_RELIABLE, false, std::make_tuple(static_cast< CommonAPI::SomeIP::IntegerDeployment<uint32_t>* >(nullptr), static_cast< CommonAPI::SomeIP::IntegerDeployment<uint32_t>* >(nullptr), static_cast< CommonAPI::SomeIP::ByteBufferDeployment* >(nullptr), static_cast< CommonAPI::EmptyDeployment* >(nullptr)))
 {
 }
 
@@ -60,6 +64,10 @@ FileTransferSomeIPProxy::FileChunkEvent& FileTransferSomeIPProxy::getFileChunkEv
     return fileChunk_;
 }
 
+FileTransferSomeIPProxy::SessionChunkEvent& FileTransferSomeIPProxy::getSessionChunkEvent() {
+    return sessionChunk_;
+}
+
 void FileTransferSomeIPProxy::requestUpdate(uint32_t _currentVersion, CommonAPI::CallStatus &_internalCallStatus, FileTransfer::UpdateInfo &_info_, const CommonAPI::CallInfo *_info) {
     CommonAPI::Deployable< uint32_t, CommonAPI::SomeIP::IntegerDeployment<uint32_t>> deploy_currentVersion(_currentVersion, static_cast< CommonAPI::SomeIP::IntegerDeployment<uint32_t>* >(nullptr));
     CommonAPI::Deployable< FileTransfer::UpdateInfo, ::v0::filetransfer::example::FileTransfer_::UpdateInfoDeployment_t> deploy_info_(static_cast< ::v0::filetransfer::example::FileTransfer_::UpdateInfoDeployment_t* >(nullptr));
@@ -176,6 +184,310 @@ std::future<CommonAPI::CallStatus> FileTransferSomeIPProxy::startTransferAsync(c
         std::make_tuple(deploy_accepted));
 }
 
+void FileTransferSomeIPProxy::ackChunks(uint32_t _sessionId, uint32_t _nextChunk, CommonAPI::CallStatus &_internalCallStatus, bool &_known, const CommonAPI::CallInfo *_info) {
+    CommonAPI::Deployable< uint32_t, CommonAPI::SomeIP::IntegerDeployment<uint32_t>> deploy_sessionId(_sessionId, static_cast< CommonAPI::SomeIP::IntegerDeployment<uint32_t>* >(nullptr));
+    CommonAPI::Deployable< uint32_t, CommonAPI::SomeIP::IntegerDeployment<uint32_t>> deploy_nextChunk(_nextChunk, static_cast< CommonAPI::SomeIP::IntegerDeployment<uint32_t>* >(nullptr));
+    CommonAPI::Deployable< bool, CommonAPI::EmptyDeployment> deploy_known(static_cast< CommonAPI::EmptyDeployment* >(nullptr));
+    CommonAPI::SomeIP::ProxyHelper<
+        CommonAPI::SomeIP::SerializableArguments<
+            CommonAPI::Deployable<
+                uint32_t,
+                CommonAPI::SomeIP::IntegerDeployment<uint32_t>
+            >,
+            CommonAPI::Deployable<
+                uint32_t,
+                CommonAPI::SomeIP::IntegerDeployment<uint32_t>
+            >
+        >,
+        CommonAPI::SomeIP::SerializableArguments<
+            CommonAPI::Deployable<
+                bool,
+                CommonAPI::EmptyDeployment
+            >
+        >
+    >::callMethodWithReply(
+        *this,
+        CommonAPI::SomeIP::method_id_t(0x3),
+        true,
+        false,
+        (_info ? _info : &CommonAPI::SomeIP::defaultCallInfo),
+        deploy_sessionId, deploy_nextChunk,
+        _internalCallStatus,
+        deploy_known);
+    _known = deploy_known.getValue();
+}
+
+std::future<CommonAPI::CallStatus> FileTransferSomeIPProxy::ackChunksAsync(const uint32_t &_sessionId, const uint32_t &_nextChunk, AckChunksAsyncCallback _callback, const CommonAPI::CallInfo *_info) {
+    CommonAPI::Deployable< uint32_t, CommonAPI::SomeIP::IntegerDeployment<uint32_t>> deploy_sessionId(_sessionId, static_cast< CommonAPI::SomeIP::IntegerDeployment<uint32_t>* >(nullptr));
+    CommonAPI::Deployable< uint32_t, CommonAPI::SomeIP::IntegerDeployment<uint32_t>> deploy_nextChunk(_nextChunk, static_cast< CommonAPI::SomeIP::IntegerDeployment<uint32_t>* >(nullptr));
+    CommonAPI::Deployable< bool, CommonAPI::EmptyDeployment> deploy_known(static_cast< CommonAPI::EmptyDeployment* >(nullptr));
+    return CommonAPI::SomeIP::ProxyHelper<
+        CommonAPI::SomeIP::SerializableArguments<
+            CommonAPI::Deployable<
+                uint32_t,
+                CommonAPI::SomeIP::IntegerDeployment<uint32_t>
+            >,
+            CommonAPI::Deployable<
+                uint32_t,
+                CommonAPI::SomeIP::IntegerDeployment<uint32_t>
+            >
+        >,
+        CommonAPI::SomeIP::SerializableArguments<
+            CommonAPI::Deployable<
+                bool,
+                CommonAPI::EmptyDeployment
+            >
+        >
+    >::callMethodAsync(
+        *this,
+        CommonAPI::SomeIP::method_id_t(0x3),
+        true,
+        false,
+        (_info ? _info : &CommonAPI::SomeIP::defaultCallInfo),
+        deploy_sessionId, deploy_nextChunk,
+        [_callback] (CommonAPI::CallStatus _internalCallStatus, CommonAPI::Deployable< bool, CommonAPI::EmptyDeployment > _known) {
+            if (_callback)
+                _callback(_internalCallStatus, _known.getValue());
+        },
+        std::make_tuple(deploy_known));
+}
+
+void FileTransferSomeIPProxy::reportVerification(uint32_t _sessionId, bool _verified, uint32_t _crc, std::string _sha256, CommonAPI::CallStatus &_internalCallStatus, bool &_known, const CommonAPI::CallInfo *_info) {
+    CommonAPI::Deployable< uint32_t, CommonAPI::SomeIP::IntegerDeployment<uint32_t>> deploy_sessionId(_sessionId, static_cast< CommonAPI::SomeIP::IntegerDeployment<uint32_t>* >(nullptr));
+    CommonAPI::Deployable< bool, CommonAPI::EmptyDeployment> deploy_verified(_verified, static_cast< CommonAPI::EmptyDeployment* >(nullptr));
+    CommonAPI::Deployable< uint32_t, CommonAPI::SomeIP::IntegerDeployment<uint32_t>> deploy_crc(_crc, static_cast< CommonAPI::SomeIP::IntegerDeployment<uint32_t>* >(nullptr));
+    CommonAPI::Deployable< std::string, CommonAPI::SomeIP::StringDeployment> deploy_sha256(_sha256, static_cast< CommonAPI::SomeIP::StringDeployment* >(nullptr));
+    CommonAPI::Deployable< bool, CommonAPI::EmptyDeployment> deploy_known(static_cast< CommonAPI::EmptyDeployment* >(nullptr));
+    CommonAPI::SomeIP::ProxyHelper<
+        CommonAPI::SomeIP::SerializableArguments<
+            CommonAPI::Deployable<
+                uint32_t,
+                CommonAPI::SomeIP::IntegerDeployment<uint32_t>
+            >,
+            CommonAPI::Deployable<
+                bool,
+                CommonAPI::EmptyDeployment
+            >,
+            CommonAPI::Deployable<
+                uint32_t,
+                CommonAPI::SomeIP::IntegerDeployment<uint32_t>
+            >,
+            CommonAPI::Deployable<
+                std::string,
+                CommonAPI::SomeIP::StringDeployment
+            >
+        >,
+        CommonAPI::SomeIP::SerializableArguments<
+            CommonAPI::Deployable<
+                bool,
+                CommonAPI::EmptyDeployment
+            >
+        >
+    >::callMethodWithReply(
+        *this,
+        CommonAPI::SomeIP::method_id_t(0x4),
+        true,
+        false,
+        (_info ? _info : &CommonAPI::SomeIP::defaultCallInfo),
+        deploy_sessionId, deploy_verified, deploy_crc, deploy_sha256,
+        _internalCallStatus,
+        deploy_known);
+    _known = deploy_known.getValue();
+}
+
+std::future<CommonAPI::CallStatus> FileTransferSomeIPProxy::reportVerificationAsync(const uint32_t &_sessionId, const bool &_verified, const uint32_t &_crc, const std::string &_sha256, ReportVerificationAsyncCallback _callback, const CommonAPI::CallInfo *_info) {
+    CommonAPI::Deployable< uint32_t, CommonAPI::SomeIP::IntegerDeployment<uint32_t>> deploy_sessionId(_sessionId, static_cast< CommonAPI::SomeIP::IntegerDeployment<uint32_t>* >(nullptr));
+    CommonAPI::Deployable< bool, CommonAPI::EmptyDeployment> deploy_verified(_verified, static_cast< CommonAPI::EmptyDeployment* >(nullptr));
+    CommonAPI::Deployable< uint32_t, CommonAPI::SomeIP::IntegerDeployment<uint32_t>> deploy_crc(_crc, static_cast< CommonAPI::SomeIP::IntegerDeployment<uint32_t>* >(nullptr));
+    CommonAPI::Deployable< std::string, CommonAPI::SomeIP::StringDeployment> deploy_sha256(_sha256, static_cast< CommonAPI::SomeIP::StringDeployment* >(nullptr));
+    CommonAPI::Deployable< bool, CommonAPI::EmptyDeployment> deploy_known(static_cast< CommonAPI::EmptyDeployment* >(nullptr));
+    return CommonAPI::SomeIP::ProxyHelper<
+        CommonAPI::SomeIP::SerializableArguments<
+            CommonAPI::Deployable<
+                uint32_t,
+                CommonAPI::SomeIP::IntegerDeployment<uint32_t>
+            >,
+            CommonAPI::Deployable<
+                bool,
+                CommonAPI::EmptyDeployment
+            >,
+            CommonAPI::Deployable<
+                uint32_t,
+                CommonAPI::SomeIP::IntegerDeployment<uint32_t>
+            >,
+            CommonAPI::Deployable<
+                std::string,
+                CommonAPI::SomeIP::StringDeployment
+            >
+        >,
+        CommonAPI::SomeIP::SerializableArguments<
+            CommonAPI::Deployable<
+                bool,
+                CommonAPI::EmptyDeployment
+            >
+        >
+    >::callMethodAsync(
+        *this,
+        CommonAPI::SomeIP::method_id_t(0x4),
+        true,
+        false,
+        (_info ? _info : &CommonAPI::SomeIP::defaultCallInfo),
+        deploy_sessionId, deploy_verified, deploy_crc, deploy_sha256,
+        [_callback] (CommonAPI::CallStatus _internalCallStatus, CommonAPI::Deployable< bool, CommonAPI::EmptyDeployment > _known) {
+            if (_callback)
+                _callback(_internalCallStatus, _known.getValue());
+        },
+        std::make_tuple(deploy_known));
+}
+
+void FileTransferSomeIPProxy::checkUpdate(uint32_t _currentVersion, CommonAPI::CallStatus &_internalCallStatus, FileTransfer::UpdateInfo &_info_, std::string &_sha256, const CommonAPI::CallInfo *_info) {
+    CommonAPI::Deployable< uint32_t, CommonAPI::SomeIP::IntegerDeployment<uint32_t>> deploy_currentVersion(_currentVersion, static_cast< CommonAPI::SomeIP::IntegerDeployment<uint32_t>* >(nullptr));
+    CommonAPI::Deployable< FileTransfer::UpdateInfo, ::v0::filetransfer::example::FileTransfer_::UpdateInfoDeployment_t> deploy_info_(static_cast< ::v0::filetransfer::example::FileTransfer_::UpdateInfoDeployment_t* >(nullptr));
+    CommonAPI::Deployable< std::string, CommonAPI::SomeIP::StringDeployment> deploy_sha256(static_cast< CommonAPI::SomeIP::StringDeployment* >(nullptr));
+    CommonAPI::SomeIP::ProxyHelper<
+        CommonAPI::SomeIP::SerializableArguments<
+            CommonAPI::Deployable<
+                uint32_t,
+                CommonAPI::SomeIP::IntegerDeployment<uint32_t>
+            >
+        >,
+        CommonAPI::SomeIP::SerializableArguments<
+            CommonAPI::Deployable<
+                FileTransfer::UpdateInfo,
+                ::v0::filetransfer::example::FileTransfer_::UpdateInfoDeployment_t
+            >,
+            CommonAPI::Deployable<
+                std::string,
+                CommonAPI::SomeIP::StringDeployment
+            >
+        >
+    >::callMethodWithReply(
+        *this,
+        CommonAPI::SomeIP::method_id_t(0x5),
+        true,
+        false,
+        (_info ? _info : &CommonAPI::SomeIP::defaultCallInfo),
+        deploy_currentVersion,
+        _internalCallStatus,
+        deploy_info_, deploy_sha256);
+    _info_ = deploy_info_.getValue();
+    _sha256 = deploy_sha256.getValue();
+}
+
+std::future<CommonAPI::CallStatus> FileTransferSomeIPProxy::checkUpdateAsync(const uint32_t &_currentVersion, CheckUpdateAsyncCallback _callback, const CommonAPI::CallInfo *_info) {
+    CommonAPI::Deployable< uint32_t, CommonAPI::SomeIP::IntegerDeployment<uint32_t>> deploy_currentVersion(_currentVersion, static_cast< CommonAPI::SomeIP::IntegerDeployment<uint32_t>* >(nullptr));
+    CommonAPI::Deployable< FileTransfer::UpdateInfo, ::v0::filetransfer::example::FileTransfer_::UpdateInfoDeployment_t> deploy_info_(static_cast< ::v0::filetransfer::example::FileTransfer_::UpdateInfoDeployment_t* >(nullptr));
+    CommonAPI::Deployable< std::string, CommonAPI::SomeIP::StringDeployment> deploy_sha256(static_cast< CommonAPI::SomeIP::StringDeployment* >(nullptr));
+    return CommonAPI::SomeIP::ProxyHelper<
+        CommonAPI::SomeIP::SerializableArguments<
+            CommonAPI::Deployable<
+                uint32_t,
+                CommonAPI::SomeIP::IntegerDeployment<uint32_t>
+            >
+        >,
+        CommonAPI::SomeIP::SerializableArguments<
+            CommonAPI::Deployable<
+                FileTransfer::UpdateInfo,
+                ::v0::filetransfer::example::FileTransfer_::UpdateInfoDeployment_t
+            >,
+            CommonAPI::Deployable<
+                std::string,
+                CommonAPI::SomeIP::StringDeployment
+            >
+        >
+    >::callMethodAsync(
+        *this,
+        CommonAPI::SomeIP::method_id_t(0x5),
+        true,
+        false,
+        (_info ? _info : &CommonAPI::SomeIP::defaultCallInfo),
+        deploy_currentVersion,
+        [_callback] (CommonAPI::CallStatus _internalCallStatus, CommonAPI::Deployable< FileTransfer::UpdateInfo, ::v0::filetransfer::example::FileTransfer_::UpdateInfoDeployment_t > _info_, CommonAPI::Deployable< std::string, CommonAPI::SomeIP::StringDeployment > _sha256) {
+            if (_callback)
+                _callback(_internalCallStatus, _info_.getValue(), _sha256.getValue());
+        },
+        std::make_tuple(deploy_info_, deploy_sha256));
+}
+
+void FileTransferSomeIPProxy::startSession(std::string _fileName, FileTransfer::TransferRequest _request, CommonAPI::CallStatus &_internalCallStatus, bool &_accepted, FileTransfer::TransferSession &_session, const CommonAPI::CallInfo *_info) {
+    CommonAPI::Deployable< std::string, CommonAPI::SomeIP::StringDeployment> deploy_fileName(_fileName, static_cast< CommonAPI::SomeIP::StringDeployment* >(nullptr));
+    CommonAPI::Deployable< FileTransfer::TransferRequest, ::v0::filetransfer::example::FileTransfer_::TransferRequestDeployment_t> deploy_request(_request, static_cast< ::v0::filetransfer::example::FileTransfer_::TransferRequestDeployment_t* >(nullptr));
+    CommonAPI::Deployable< bool, CommonAPI::EmptyDeployment> deploy_accepted(static_cast< CommonAPI::EmptyDeployment* >(nullptr));
+    CommonAPI::Deployable< FileTransfer::TransferSession, ::v0::filetransfer::example::FileTransfer_::TransferSessionDeployment_t> deploy_session(static_cast< ::v0::filetransfer::example::FileTransfer_::TransferSessionDeployment_t* >(nullptr));
+    CommonAPI::SomeIP::ProxyHelper<
+        CommonAPI::SomeIP::SerializableArguments<
+            CommonAPI::Deployable<
+                std::string,
+                CommonAPI::SomeIP::StringDeployment
+            >,
+            CommonAPI::Deployable<
+                FileTransfer::TransferRequest,
+                ::v0::filetransfer::example::FileTransfer_::TransferRequestDeployment_t
+            >
+        >,
+        CommonAPI::SomeIP::SerializableArguments<
+            CommonAPI::Deployable<
+                bool,
+                CommonAPI::EmptyDeployment
+            >,
+            CommonAPI::Deployable<
+                FileTransfer::TransferSession,
+                ::v0::filetransfer::example::FileTransfer_::TransferSessionDeployment_t
+            >
+        >
+    >::callMethodWithReply(
+        *this,
+        CommonAPI::SomeIP::method_id_t(0x6),
+        true,
+        false,
+        (_info ? _info : &CommonAPI::SomeIP::defaultCallInfo),
+        deploy_fileName, deploy_request,
+        _internalCallStatus,
+        deploy_accepted, deploy_session);
+    _accepted = deploy_accepted.getValue();
+    _session = deploy_session.getValue();
+}
+
+std::future<CommonAPI::CallStatus> FileTransferSomeIPProxy::startSessionAsync(const std::string &_fileName, const FileTransfer::TransferRequest &_request, StartSessionAsyncCallback _callback, const CommonAPI::CallInfo *_info) {
+    CommonAPI::Deployable< std::string, CommonAPI::SomeIP::StringDeployment> deploy_fileName(_fileName, static_cast< CommonAPI::SomeIP::StringDeployment* >(nullptr));
+    CommonAPI::Deployable< FileTransfer::TransferRequest, ::v0::filetransfer::example::FileTransfer_::TransferRequestDeployment_t> deploy_request(_request, static_cast< ::v0::filetransfer::example::FileTransfer_::TransferRequestDeployment_t* >(nullptr));
+    CommonAPI::Deployable< bool, CommonAPI::EmptyDeployment> deploy_accepted(static_cast< CommonAPI::EmptyDeployment* >(nullptr));
+    CommonAPI::Deployable< FileTransfer::TransferSession, ::v0::filetransfer::example::FileTransfer_::TransferSessionDeployment_t> deploy_session(static_cast< ::v0::filetransfer::example::FileTransfer_::TransferSessionDeployment_t* >(nullptr));
+    return CommonAPI::SomeIP::ProxyHelper<
+        CommonAPI::SomeIP::SerializableArguments<
+            CommonAPI::Deployable<
+                std::string,
+                CommonAPI::SomeIP::StringDeployment
+            >,
+            CommonAPI::Deployable<
+                FileTransfer::TransferRequest,
+                ::v0::filetransfer::example::FileTransfer_::TransferRequestDeployment_t
+            >
+        >,
+        CommonAPI::SomeIP::SerializableArguments<
+            CommonAPI::Deployable<
+                bool,
+                CommonAPI::EmptyDeployment
+            >,
+            CommonAPI::Deployable<
+                FileTransfer::TransferSession,
+                ::v0::filetransfer::example::FileTransfer_::TransferSessionDeployment_t
+            >
+        >
+    >::callMethodAsync(
+        *this,
+        CommonAPI::SomeIP::method_id_t(0x6),
+        true,
+        false,
+        (_info ? _info : &CommonAPI::SomeIP::defaultCallInfo),
+        deploy_fileName, deploy_request,
+        [_callback] (CommonAPI::CallStatus _internalCallStatus, CommonAPI::Deployable< bool, CommonAPI::EmptyDeployment > _accepted, CommonAPI::Deployable< FileTransfer::TransferSession, ::v0::filetransfer::example::FileTransfer_::TransferSessionDeployment_t > _session) {
+            if (_callback)
+                _callback(_internalCallStatus, _accepted.getValue(), _session.getValue());
+        },
+        std::make_tuple(deploy_accepted, deploy_session));
+}
+
 void FileTransferSomeIPProxy::getOwnVersion(uint16_t& ownVersionMajor, uint16_t& ownVersionMinor) const {
     ownVersionMajor = 0;
     ownVersionMinor = 1;
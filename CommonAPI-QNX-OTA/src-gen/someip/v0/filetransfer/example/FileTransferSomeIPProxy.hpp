@@ -58,6 +58,8 @@ public:
 
     virtual FileChunkEvent& getFileChunkEvent();
 
+    virtual SessionChunkEvent& getSessionChunkEvent();
+
     virtual void requestUpdate(uint32_t _currentVersion, CommonAPI::CallStatus &_internalCallStatus, FileTransfer::UpdateInfo &_info_, const CommonAPI::CallInfo *_info);
 
     virtual std::future<CommonAPI::CallStatus> requestUpdateAsync(const uint32_t &_currentVersion, RequestUpdateAsyncCallback _callback, const CommonAPI::CallInfo *_info);
@@ -66,12 +68,29 @@ public:
 
     virtual std::future<CommonAPI::CallStatus> startTransferAsync(const std::string &_fileName, StartTransferAsyncCallback _callback, const CommonAPI::CallInfo *_info);
 
+    virtual void ackChunks(uint32_t _sessionId, uint32_t _nextChunk, CommonAPI::CallStatus &_internalCallStatus, bool &_known, const CommonAPI::CallInfo *_info);
+
+    virtual std::future<CommonAPI::CallStatus> ackChunksAsync(const uint32_t &_sessionId, const uint32_t &_nextChunk, AckChunksAsyncCallback _callback, const CommonAPI::CallInfo *_info);
+
+    virtual void reportVerification(uint32_t _sessionId, bool _verified, uint32_t _crc, std::string _sha256, CommonAPI::CallStatus &_internalCallStatus, bool &_known, const CommonAPI::CallInfo *_info);
+
+    virtual std::future<CommonAPI::CallStatus> reportVerificationAsync(const uint32_t &_sessionId, const bool &_verified, const uint32_t &_crc, const std::string &_sha256, ReportVerificationAsyncCallback _callback, const CommonAPI::CallInfo *_info);
+
+    virtual void checkUpdate(uint32_t _currentVersion, CommonAPI::CallStatus &_internalCallStatus, FileTransfer::UpdateInfo &_info_, std::string &_sha256, const CommonAPI::CallInfo *_info);
+
+    virtual std::future<CommonAPI::CallStatus> checkUpdateAsync(const uint32_t &_currentVersion, CheckUpdateAsyncCallback _callback, const CommonAPI::CallInfo *_info);
+
+    virtual void startSession(std::string _fileName, FileTransfer::TransferRequest _request, CommonAPI::CallStatus &_internalCallStatus, bool &_accepted, FileTransfer::TransferSession &_session, const CommonAPI::CallInfo *_info);
+
+    virtual std::future<CommonAPI::CallStatus> startSessionAsync(const std::string &_fileName, const FileTransfer::TransferRequest &_request, StartSessionAsyncCallback _callback, const CommonAPI::CallInfo *_info);
+
     virtual void getOwnVersion(uint16_t &_major, uint16_t &_minor) const;
 
     virtual std::future<void> getCompletionFuture();
 
 private:
     CommonAPI::SomeIP::Event<FileChunkEvent, CommonAPI::Deployable< uint32_t, CommonAPI::SomeIP::IntegerDeployment<uint32_t> >, CommonAPI::Deployable< CommonAPI::ByteBuffer, CommonAPI::SomeIP::ByteBufferDeployment >, CommonAPI::Deployable< bool, CommonAPI::EmptyDeployment >> fileChunk_;
+    CommonAPI::SomeIP::Event<SessionChunkEvent, CommonAPI::Deployable< uint32_t, CommonAPI::SomeIP::IntegerDeployment<uint32_t> >, CommonAPI::Deployable< uint32_t, CommonAPI::SomeIP::IntegerDeployment<uint32_t> >, CommonAPI::Deployable< CommonAPI::ByteBuffer, CommonAPI::SomeIP::ByteBufferDeployment >, CommonAPI::Deployable< bool, CommonAPI::EmptyDeployment >> sessionChunk_;
 
 };
 
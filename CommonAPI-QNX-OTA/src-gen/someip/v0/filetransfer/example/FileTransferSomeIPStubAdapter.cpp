@@ -37,6 +37,9 @@ void initializeFileTransferSomeIPStubAdapter() {
     CommonAPI::SomeIP::AddressTranslator::get()->insert(
         "local:filetransfer.example.FileTransfer:v0_1:filetransfer.example.FileTransfer",
          0x6000, 0x7000, 0, 1);
+    CommonAPI::SomeIP::AddressTranslator::get()->insert(
+        "local:filetransfer.example.FileTransfer:v0_1:filetransfer.example.FileTransferPeer",
+         0x6000, 0x7001, 0, 1);
     CommonAPI::SomeIP::Factory::get()->registerStubAdapterCreateMethod(
         "filetransfer.example.FileTransfer:v0_1",
         &createFileTransferSomeIPStubAdapter);
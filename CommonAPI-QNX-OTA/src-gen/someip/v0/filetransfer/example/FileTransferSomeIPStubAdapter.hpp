@@ -49,6 +49,7 @@ public:
     }
 
     void fireFileChunkEvent(const uint32_t &_chunkIndex, const CommonAPI::ByteBuffer &_data, const bool &_lastChunk);
+    void fireSessionChunkEvent(const uint32_t &_sessionId, const uint32_t &_chunkIndex, const CommonAPI::ByteBuffer &_data, const bool &_lastChunk);
 
     void deactivateManagedInstances() {}
     
@@ -73,6 +74,38 @@ public:
         std::tuple< CommonAPI::EmptyDeployment>
     > startTransferStubDispatcher;
     
+    CommonAPI::SomeIP::MethodWithReplyStubDispatcher<
+        ::v0::filetransfer::example::FileTransferStub,
+        std::tuple< uint32_t, uint32_t>,
+        std::tuple< bool>,
+        std::tuple< CommonAPI::SomeIP::IntegerDeployment<uint32_t>, CommonAPI::SomeIP::IntegerDeployment<uint32_t>>,
+        std::tuple< CommonAPI::EmptyDeployment>
+    > ackChunksStubDispatcher;
+    
+    CommonAPI::SomeIP::MethodWithReplyStubDispatcher<
+        ::v0::filetransfer::example::FileTransferStub,
+        std::tuple< uint32_t, bool, uint32_t, std::string>,
+        std::tuple< bool>,
+        std::tuple< CommonAPI::SomeIP::IntegerDeployment<uint32_t>, CommonAPI::EmptyDeployment, CommonAPI::SomeIP::IntegerDeployment<uint32_t>, CommonAPI::SomeIP::StringDeployment>,
+        std::tuple< CommonAPI::EmptyDeployment>
+    > reportVerificationStubDispatcher;
+    
+    CommonAPI::SomeIP::MethodWithReplyStubDispatcher<
+        ::v0::filetransfer::example::FileTransferStub,
+        std::tuple< uint32_t>,
+        std::tuple< FileTransfer::UpdateInfo, std::string>,
+        std::tuple< CommonAPI::SomeIP::IntegerDeployment<uint32_t>>,
+        std::tuple< ::v0::filetransfer::example::FileTransfer_::UpdateInfoDeployment_t, CommonAPI::SomeIP::StringDeployment>
+    > checkUpdateStubDispatcher;
+    
+    CommonAPI::SomeIP::MethodWithReplyStubDispatcher<
+        ::v0::filetransfer::example::FileTransferStub,
+        std::tuple< std::string, FileTransfer::TransferRequest>,
+        std::tuple< bool, FileTransfer::TransferSession>,
+        std::tuple< CommonAPI::SomeIP::StringDeployment, ::v0::filetransfer::example::FileTransfer_::TransferRequestDeployment_t>,
+        std::tuple< CommonAPI::EmptyDeployment, ::v0::filetransfer::example::FileTransfer_::TransferSessionDeployment_t>
+    > startSessionStubDispatcher;
+    
     FileTransferSomeIPStubAdapterInternal(
         const CommonAPI::SomeIP::Address &_address,
         const std::shared_ptr<CommonAPI::SomeIP::ProxyConnection> &_connection,
@@ -98,15 +131,56 @@ public:
             std::make_tuple(static_cast< CommonAPI::SomeIP::StringDeployment* >(nullptr)),
             std::make_tuple(static_cast< CommonAPI::EmptyDeployment* >(nullptr)))
         
+        ,
+        ackChunksStubDispatcher(
+            &FileTransferStub::ackChunks,
+            false,
+            _stub->hasElement(2),
+            std::make_tuple(static_cast< CommonAPI::SomeIP::IntegerDeployment<uint32_t>* >(nullptr), static_cast< CommonAPI::SomeIP::IntegerDeployment<uint32_t>* >(nullptr)),
+            std::make_tuple(static_cast< CommonAPI::EmptyDeployment* >(nullptr)))
+        
+        ,
+        reportVerificationStubDispatcher(
+            &FileTransferStub::reportVerification,
+            false,
+            _stub->hasElement(3),
+            std::make_tuple(static_cast< CommonAPI::SomeIP::IntegerDeployment<uint32_t>* >(nullptr), static_cast< CommonAPI::EmptyDeployment* >(nullptr), static_cast< CommonAPI::SomeIP::IntegerDeployment<uint32_t>* >(nullptr), static_cast< CommonAPI::SomeIP::StringDeployment* >(nullptr)),
+            std::make_tuple(static_cast< CommonAPI::EmptyDeployment* >(nullptr)))
+        
+        ,
+        checkUpdateStubDispatcher(
+            &FileTransferStub::checkUpdate,
+            false,
+            _stub->hasElement(4),
+            std::make_tuple(static_cast< CommonAPI::SomeIP::IntegerDeployment<uint32_t>* >(nullptr)),
+            std::make_tuple(static_cast< ::v0::filetransfer::example::FileTransfer_::UpdateInfoDeployment_t* >(nullptr), static_cast< CommonAPI::SomeIP::StringDeployment* >(nullptr)))
+        
+        ,
+        startSessionStubDispatcher(
+            &FileTransferStub::startSession,
+            false,
+            _stub->hasElement(5),
+            std::make_tuple(static_cast< CommonAPI::SomeIP::StringDeployment* >(nullptr), static_cast< ::v0::filetransfer::example::FileTransfer_::TransferRequestDeployment_t* >(nullptr)),
+            std::make_tuple(static_cast< CommonAPI::EmptyDeployment* >(nullptr), static_cast< ::v0::filetransfer::example::FileTransfer_::TransferSessionDeployment_t* >(nullptr)))
+        
     {
         FileTransferSomeIPStubAdapterHelper::addStubDispatcher( { CommonAPI::SomeIP::method_id_t(0x1) }, &requestUpdateStubDispatcher );
         FileTransferSomeIPStubAdapterHelper::addStubDispatcher( { CommonAPI::SomeIP::method_id_t(0x2) }, &startTransferStubDispatcher );
+        FileTransferSomeIPStubAdapterHelper::addStubDispatcher( { CommonAPI::SomeIP::method_id_t(0x3) }, &ackChunksStubDispatcher );
+        FileTransferSomeIPStubAdapterHelper::addStubDispatcher( { CommonAPI::SomeIP::method_id_t(0x4) }, &reportVerificationStubDispatcher );
+        FileTransferSomeIPStubAdapterHelper::addStubDispatcher( { CommonAPI::SomeIP::method_id_t(0x5) }, &checkUpdateStubDispatcher );
+        FileTransferSomeIPStubAdapterHelper::addStubDispatcher( { CommonAPI::SomeIP::method_id_t(0x6) }, &startSessionStubDispatcher );
         // Provided events/fields
         {
             std::set<CommonAPI::SomeIP::eventgroup_id_t> itsEventGroups;
             itsEventGroups.insert(CommonAPI::SomeIP::eventgroup_id_t(0x2000));
             CommonAPI::SomeIP::StubAdapter::registerEvent(CommonAPI::SomeIP::event_id_t(0x8020), itsEventGroups, CommonAPI::SomeIP::event_type_e::ET_EVENT, CommonAPI::SomeIP::reliability_type_e::RT_RELIABLE);
         }
+        {
+            std::set<CommonAPI::SomeIP::eventgroup_id_t> itsEventGroups;
+            itsEventGroups.insert(CommonAPI::SomeIP::eventgroup_id_t(0x2001));
+            CommonAPI::SomeIP::StubAdapter::registerEvent(CommonAPI::SomeIP::event_id_t(0x8021), itsEventGroups, CommonAPI::SomeIP::event_type_e::ET_EVENT, CommonAPI::SomeIP::reliability_type_e::RT_RELIABLE);
+        }
     }
 
     // Register/Unregister event handlers for selective broadcasts
@@ -134,6 +208,28 @@ void FileTransferSomeIPStubAdapterInternal<_Stub, _Stubs...>::fireFileChunkEvent
 }
 
 
+template <typename _Stub, typename... _Stubs>
+void FileTransferSomeIPStubAdapterInternal<_Stub, _Stubs...>::fireSessionChunkEvent(const uint32_t &_sessionId, const uint32_t &_chunkIndex, const CommonAPI::ByteBuffer &_data, const bool &_lastChunk) {
+    CommonAPI::Deployable< uint32_t, CommonAPI::SomeIP::IntegerDeployment<uint32_t>> deployed_sessionId(_sessionId, static_cast< CommonAPI::SomeIP::IntegerDeployment<uint32_t>* >(nullptr));
+    CommonAPI::Deployable< uint32_t, CommonAPI::SomeIP::IntegerDeployment<uint32_t>> deployed_chunkIndex(_chunkIndex, static_cast< CommonAPI::SomeIP::IntegerDeployment<uint32_t>* >(nullptr));
+    CommonAPI::Deployable< CommonAPI::ByteBuffer, CommonAPI::SomeIP::ByteBufferDeployment> deployed_data(_data, static_cast< CommonAPI::SomeIP::ByteBufferDeployment* >(nullptr));
+    CommonAPI::SomeIP::StubEventHelper<CommonAPI::SomeIP::SerializableArguments<  CommonAPI::Deployable< uint32_t, CommonAPI::SomeIP::IntegerDeployment<uint32_t> > 
+    ,  CommonAPI::Deployable< uint32_t, CommonAPI::SomeIP::IntegerDeployment<uint32_t> > 
+    ,  CommonAPI::Deployable< CommonAPI::ByteBuffer, CommonAPI::SomeIP::ByteBufferDeployment > 
+    ,  bool
+    >>
+        ::sendEvent(
+            *this,
+            CommonAPI::SomeIP::event_id_t(0x8021),
+            false,
+             deployed_sessionId 
+            ,  deployed_chunkIndex 
+            ,  deployed_data 
+            , _lastChunk
+    );
+}
+
+
 template <typename _Stub, typename... _Stubs>
 void FileTransferSomeIPStubAdapterInternal<_Stub, _Stubs...>::registerSelectiveEventHandlers() {
 
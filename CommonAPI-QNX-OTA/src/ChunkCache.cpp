@@ -0,0 +1,106 @@
+#include "ChunkCache.hpp"
+
+ChunkCache::ChunkCache(size_t budgetBytes) : budget_(budgetBytes) {}
+
+ChunkCache::Chunk ChunkCache::getOrLoad(uint64_t imageId, uint32_t index, const Loader& load) {
+    const Key key{imageId, index};
+    std::promise<Chunk> promise;
+
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+
+        auto it = index_.find(key);
+        if (it != index_.end()) {
+            Slot& slot = slots_[it->second];
+            slot.referenced = true;
+            ++stats_.hits;
+            return slot.data;
+        }
+
+        // Another session is already reading this chunk: wait for its result
+        auto pending = inFlight_.find(key);
+        if (pending != inFlight_.end()) {
+            std::shared_future<Chunk> result = pending->second;
+            ++stats_.hits;
+            lock.unlock();
+            return result.get();
+        }
+
+        ++stats_.misses;
+        inFlight_.emplace(key, promise.get_future().share());
+    }
+
+    // Storage read happens outside the lock
+    std::shared_ptr<std::vector<uint8_t>> buffer = std::make_shared<std::vector<uint8_t>>();
+    Chunk chunk;
+    if (load(*buffer)) chunk = buffer;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        inFlight_.erase(key);
+        if (chunk && chunk->size() <= budget_) insertLocked(key, chunk);
+    }
+
+    promise.set_value(chunk);
+    return chunk;
+}
+
+bool ChunkCache::contains(uint64_t imageId, uint32_t index) const {
+    const Key key{imageId, index};
+    std::lock_guard<std::mutex> lock(mutex_);
+    return index_.count(key) > 0 || inFlight_.count(key) > 0;
+}
+
+ChunkCache::Stats ChunkCache::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats s = stats_;
+    s.bytesCached = used_;
+    s.entries = index_.size();
+    return s;
+}
+
+void ChunkCache::setBudget(size_t budgetBytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    budget_ = budgetBytes;
+    while (used_ > budget_ && !index_.empty()) evictOneLocked();
+}
+
+void ChunkCache::insertLocked(const Key& key, const Chunk& data) {
+    while (used_ + data->size() > budget_ && !index_.empty()) evictOneLocked();
+
+    size_t pos;
+    if (!freeSlots_.empty()) {
+        pos = freeSlots_.back();
+        freeSlots_.pop_back();
+        slots_[pos] = Slot{key, data, false};
+    } else {
+        pos = slots_.size();
+        slots_.push_back(Slot{key, data, false});
+    }
+
+    index_[key] = pos;
+    used_ += data->size();
+}
+
+void ChunkCache::evictOneLocked() {
+    // CLOCK sweep: referenced entries get a second chance, the first
+    // unreferenced one is dropped. Terminates within two laps.
+    while (true) {
+        if (hand_ >= slots_.size()) hand_ = 0;
+        Slot& slot = slots_[hand_++];
+
+        if (!slot.data) continue;
+
+        if (slot.referenced) {
+            slot.referenced = false;
+            continue;
+        }
+
+        used_ -= slot.data->size();
+        index_.erase(slot.key);
+        slot.data.reset();
+        freeSlots_.push_back(hand_ - 1);
+        ++stats_.evictions;
+        return;
+    }
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+// Process-wide cache of recently read image chunks, shared by all transfer
+// sessions. Entries are keyed by (image id, chunk index) and evicted with the
+// CLOCK (second chance) policy once the memory budget is exceeded.
+class ChunkCache {
+   public:
+    typedef std::shared_ptr<const std::vector<uint8_t>> Chunk;
+    typedef std::function<bool(std::vector<uint8_t>&)> Loader;
+
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+        size_t bytesCached = 0;
+        size_t entries = 0;
+
+        double hitRatio() const {
+            uint64_t total = hits + misses;
+            return total ? static_cast<double>(hits) / static_cast<double>(total) : 0.0;
+        }
+    };
+
+    explicit ChunkCache(size_t budgetBytes);
+
+    // Returns the chunk from the cache, or runs `load` to fill it. Concurrent
+    // misses on the same key share a single load. Returns nullptr if the load fails.
+    Chunk getOrLoad(uint64_t imageId, uint32_t index, const Loader& load);
+
+    // Whether the chunk is cached or being loaded; counts as neither hit nor use
+    bool contains(uint64_t imageId, uint32_t index) const;
+
+    Stats stats() const;
+
+    // Changes the byte budget, evicting entries until the cache fits it
+    void setBudget(size_t budgetBytes);
+
+   private:
+    struct Key {
+        uint64_t imageId;
+        uint32_t index;
+
+        bool operator==(const Key& other) const { return imageId == other.imageId && index == other.index; }
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& k) const { return std::hash<uint64_t>()(k.imageId * 0x9E3779B97F4A7C15ULL ^ k.index); }
+    };
+
+    struct Slot {
+        Key key;
+        Chunk data;
+        bool referenced;
+    };
+
+    void insertLocked(const Key& key, const Chunk& data);
+    void evictOneLocked();
+
+    size_t budget_;
+    size_t used_ = 0;
+
+    std::vector<Slot> slots_;
+    std::vector<size_t> freeSlots_;
+    size_t hand_ = 0;
+    std::unordered_map<Key, size_t, KeyHash> index_;
+    std::unordered_map<Key, std::shared_future<Chunk>, KeyHash> inFlight_;
+
+    mutable std::mutex mutex_;
+    Stats stats_;
+};
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "SpscQueue.hpp"
+
+// Stage between the thread receiving chunks and the one writing them: a
+// pool of `workers` threads runs `check` (per-chunk checksums, where a
+// compressed payload would be inflated) on several chunks at once, and
+// the consumer gets them back in the order they were pushed.
+//
+// Items are dealt round-robin to one lane per worker, each a pair of
+// lock-free SPSC rings (producer -> worker -> consumer). As every worker
+// handles its lane in FIFO order, the next item in push order is always
+// at the head of lane `popped % workers`: ordering needs no reorder
+// buffer and no lock. Neither end blocks: push() fails once `capacity`
+// items are in flight, and pop() fails while the next item is unchecked.
+//
+// With no workers, check runs inside pop() on the consumer thread.
+template <typename T>
+class ChunkPipeline {
+   public:
+    typedef std::function<void(T& item)> Check;
+
+    // Runs on a worker after it finished an item, to wake the consumer
+    typedef std::function<void()> Ready;
+
+    struct Stats {
+        unsigned workers = 0;
+        uint64_t items = 0;
+        double busySeconds = 0;  // summed over the workers
+    };
+
+    ChunkPipeline(unsigned workers, size_t capacity, Check check, Ready ready)
+        : capacity_(std::max<size_t>(capacity, 1)), check_(std::move(check)), ready_(std::move(ready)), workers_(workers) {
+        for (unsigned i = 0; i < std::max(workers, 1u); ++i) lanes_.emplace_back(new Lane(capacity_));
+        for (unsigned i = 0; i < workers; ++i) lanes_[i]->thread = std::thread(&ChunkPipeline::work, this, std::ref(*lanes_[i]));
+    }
+
+    ~ChunkPipeline() {
+        stop_ = true;
+        for (auto& lane : lanes_) {
+            { std::lock_guard<std::mutex> lock(lane->mutex); }
+            lane->wake.notify_one();
+        }
+        for (auto& lane : lanes_) {
+            if (lane->thread.joinable()) lane->thread.join();
+        }
+    }
+
+    ChunkPipeline(const ChunkPipeline&) = delete;
+    ChunkPipeline& operator=(const ChunkPipeline&) = delete;
+
+    // Producer side
+    bool push(T&& item) {
+        if (inFlight_.load(std::memory_order_acquire) >= capacity_) return false;
+
+        Lane& lane = *lanes_[pushed_ % lanes_.size()];
+        if (!(workers_ ? lane.in : lane.out).push(std::move(item))) return false;
+        ++pushed_;
+        inFlight_.fetch_add(1, std::memory_order_acq_rel);
+
+        if (workers_) {
+            // Pairs with the fence in work(), as in FileReceiver::wakeWriter
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (lane.idle.load()) {
+                { std::lock_guard<std::mutex> lock(lane.mutex); }
+                lane.wake.notify_one();
+            }
+        }
+        return true;
+    }
+
+    // Consumer side: the next item in push order, once it was checked
+    bool pop(T& item) {
+        Lane& lane = *lanes_[popped_ % lanes_.size()];
+        if (!lane.out.pop(item)) return false;
+        ++popped_;
+        inFlight_.fetch_sub(1, std::memory_order_acq_rel);
+
+        if (!workers_) {
+            const auto start = std::chrono::steady_clock::now();
+            check_(item);
+            lane.busyNs += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+            ++lane.items;
+        }
+        return true;
+    }
+
+    // Consumer side: pop() would succeed
+    bool ready() const { return !lanes_[popped_ % lanes_.size()]->out.empty(); }
+
+    Stats stats() const {
+        Stats s;
+        s.workers = workers_;
+        for (const auto& lane : lanes_) {
+            s.items += lane->items.load();
+            s.busySeconds += static_cast<double>(lane->busyNs.load()) / 1e9;
+        }
+        return s;
+    }
+
+   private:
+    struct Lane {
+        explicit Lane(size_t capacity) : in(capacity), out(capacity) {}
+
+        SpscQueue<T> in;   // producer -> worker
+        SpscQueue<T> out;  // worker -> consumer, never full: at most `capacity` items are in flight
+        std::thread thread;
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::atomic<bool> idle{false};
+        std::atomic<uint64_t> busyNs{0};
+        std::atomic<uint64_t> items{0};
+    };
+
+    void work(Lane& lane) {
+        T item;
+        while (!stop_) {
+            if (lane.in.pop(item)) {
+                const auto start = std::chrono::steady_clock::now();
+                check_(item);
+                lane.busyNs += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+                ++lane.items;
+
+                lane.out.push(std::move(item));
+                item = T();
+                if (ready_) ready_();
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(lane.mutex);
+            lane.idle = true;
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            lane.wake.wait(lock, [&] { return stop_ || !lane.in.empty(); });
+            lane.idle = false;
+        }
+    }
+
+    const size_t capacity_;
+    Check check_;
+    Ready ready_;
+    const unsigned workers_;
+    std::vector<std::unique_ptr<Lane>> lanes_;
+    std::atomic<size_t> inFlight_{0};
+    std::atomic<bool> stop_{false};
+
+    size_t pushed_ = 0;  // producer only
+    size_t popped_ = 0;  // consumer only
+};
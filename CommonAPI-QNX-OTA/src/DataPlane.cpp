@@ -0,0 +1,416 @@
+#include "DataPlane.hpp"
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/sendfile.h>
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#if !defined(MSG_NOSIGNAL)
+#define MSG_NOSIGNAL 0
+#endif
+
+namespace {
+
+// A client that stops reading for this long is dropped instead of holding a sender thread
+const int kSendTimeoutSec = 30;
+
+void putBe32(uint8_t* p, uint32_t v) {
+    for (int i = 0; i < 4; ++i) p[i] = static_cast<uint8_t>(v >> (24 - 8 * i));
+}
+
+void putBe64(uint8_t* p, uint64_t v) {
+    for (int i = 0; i < 8; ++i) p[i] = static_cast<uint8_t>(v >> (56 - 8 * i));
+}
+
+uint32_t getBe32(const uint8_t* p) {
+    uint32_t v = 0;
+    for (int i = 0; i < 4; ++i) v = (v << 8) | p[i];
+    return v;
+}
+
+uint64_t getBe64(const uint8_t* p) {
+    uint64_t v = 0;
+    for (int i = 0; i < 8; ++i) v = (v << 8) | p[i];
+    return v;
+}
+
+bool sendAll(int fd, const uint8_t* data, size_t size) {
+    while (size > 0) {
+        ssize_t n = send(fd, data, size, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+bool recvAll(int fd, uint8_t* data, size_t size) {
+    while (size > 0) {
+        ssize_t n = recv(fd, data, size, 0);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        data += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+// "tcp://host:port/token"
+bool parseEndpoint(const std::string& endpoint, std::string& host, std::string& port, uint64_t& token) {
+    const std::string scheme = "tcp://";
+    if (endpoint.compare(0, scheme.size(), scheme) != 0) return false;
+
+    size_t hostBegin = scheme.size();
+    size_t colon = endpoint.rfind(':');
+    size_t slash = endpoint.find('/', hostBegin);
+    if (colon == std::string::npos || slash == std::string::npos || colon < hostBegin || slash < colon) return false;
+
+    host = endpoint.substr(hostBegin, colon - hostBegin);
+    port = endpoint.substr(colon + 1, slash - colon - 1);
+
+    std::stringstream ss(endpoint.substr(slash + 1));
+    ss >> std::hex >> token;
+    return !ss.fail() && !host.empty() && !port.empty();
+}
+
+int connectTo(const std::string& host, const std::string& port) {
+    addrinfo hints;
+    std::memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+
+    addrinfo* res = nullptr;
+    if (getaddrinfo(host.c_str(), port.c_str(), &hints, &res) != 0 || !res) return -1;
+
+    int fd = -1;
+    for (addrinfo* ai = res; ai; ai = ai->ai_next) {
+        fd = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+        if (fd < 0) continue;
+        if (connect(fd, ai->ai_addr, ai->ai_addrlen) == 0) break;
+        close(fd);
+        fd = -1;
+    }
+    freeaddrinfo(res);
+    return fd;
+}
+
+double elapsedSeconds(std::chrono::steady_clock::time_point since) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - since).count();
+}
+
+}  // namespace
+
+void stripeRange(uint64_t size, uint32_t stripes, uint32_t stripe, uint64_t align, uint64_t& offset, uint64_t& length) {
+    if (stripes == 0) stripes = 1;
+    if (align == 0) align = 1;
+
+    uint64_t per = (size + stripes - 1) / stripes;
+    per = (per + align - 1) / align * align;
+
+    offset = std::min<uint64_t>(static_cast<uint64_t>(stripe) * per, size);
+    length = std::min<uint64_t>(per, size - offset);
+}
+
+void DataPlaneHeader::encode(uint8_t* out) const {
+    putBe32(out, magic);
+    putBe32(out + 4, flags);
+    putBe64(out + 8, offset);
+    putBe64(out + 16, length);
+}
+
+bool DataPlaneHeader::decode(const uint8_t* in) {
+    magic = getBe32(in);
+    flags = getBe32(in + 4);
+    offset = getBe64(in + 8);
+    length = getBe64(in + 16);
+    return magic == kDataPlaneMagic;
+}
+
+DataPlaneServer::DataPlaneServer(const std::string& advertiseHost, uint16_t port)
+    : host_(advertiseHost), port_(port), rng_(std::random_device{}()) {}
+
+DataPlaneServer::~DataPlaneServer() {
+    running_ = false;
+    if (listenFd_ >= 0) {
+        shutdown(listenFd_, SHUT_RDWR);
+        close(listenFd_);
+    }
+    if (acceptThread_.joinable()) acceptThread_.join();
+}
+
+bool DataPlaneServer::start() {
+    // A client dropping mid-stream must not kill the gateway
+    std::signal(SIGPIPE, SIG_IGN);
+
+    listenFd_ = socket(AF_INET, SOCK_STREAM, 0);
+    if (listenFd_ < 0) {
+        std::cerr << "[Service] Data plane: socket() failed: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    int one = 1;
+    setsockopt(listenFd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    sockaddr_in addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(port_);
+
+    if (bind(listenFd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || listen(listenFd_, 16) != 0) {
+        std::cerr << "[Service] Data plane: cannot listen on port " << port_ << ": " << std::strerror(errno) << std::endl;
+        close(listenFd_);
+        listenFd_ = -1;
+        return false;
+    }
+
+    running_ = true;
+    acceptThread_ = std::thread(&DataPlaneServer::acceptLoop, this);
+
+    std::cout << "[Service] Data plane listening on tcp port " << port_ << std::endl;
+    return true;
+}
+
+std::string DataPlaneServer::offer(const std::string& path, uint32_t stripes, uint64_t align, uint64_t from, uint64_t to) {
+    stripes = std::max<uint32_t>(1, std::min<uint32_t>(stripes, kMaxStripes));
+
+    const auto now = std::chrono::steady_clock::now();
+    uint64_t token;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        // Drop offers that were never picked up
+        for (auto it = pending_.begin(); it != pending_.end();) {
+            if (it->second.expires < now)
+                it = pending_.erase(it);
+            else
+                ++it;
+        }
+
+        do {
+            token = rng_();
+        } while (token == 0 || pending_.count(token));
+
+        pending_[token] = Pending{path, stripes, align, from, to, std::vector<bool>(stripes, false), stripes, now + std::chrono::seconds(60)};
+    }
+
+    char tokenHex[17];
+    std::snprintf(tokenHex, sizeof(tokenHex), "%016llx", static_cast<unsigned long long>(token));
+
+    std::ostringstream endpoint;
+    endpoint << "tcp://" << host_ << ":" << port_ << "/" << tokenHex;
+    return endpoint.str();
+}
+
+void DataPlaneServer::acceptLoop() {
+    while (running_) {
+        int fd = accept(listenFd_, nullptr, nullptr);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            if (running_) std::cerr << "[Service] Data plane: accept() failed: " << std::strerror(errno) << std::endl;
+            break;
+        }
+        std::thread(&DataPlaneServer::serve, this, fd).detach();
+    }
+}
+
+void DataPlaneServer::serve(int fd) {
+    timeval tv{5, 0};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    timeval sendTv{kSendTimeoutSec, 0};
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &sendTv, sizeof(sendTv));
+
+    uint8_t hello[12];
+    std::string path;
+    uint32_t stripe = 0;
+    uint32_t stripes = 1;
+    uint64_t align = 1;
+    uint64_t from = 0;
+    uint64_t to = 0;
+
+    if (recvAll(fd, hello, sizeof(hello))) {
+        uint64_t token = getBe64(hello);
+        stripe = getBe32(hello + 8);
+
+        // Each stripe of an offer may be claimed exactly once
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = pending_.find(token);
+        if (it != pending_.end() && stripe < it->second.stripes && !it->second.claimed[stripe]) {
+            Pending& p = it->second;
+            p.claimed[stripe] = true;
+            path = p.path;
+            stripes = p.stripes;
+            align = p.align;
+            from = p.from;
+            to = p.to;
+            if (--p.remaining == 0) pending_.erase(it);
+        }
+    }
+
+    if (path.empty()) {
+        std::cerr << "[Service] Data plane: rejected connection with unknown token or stripe" << std::endl;
+    } else if (!streamRange(fd, path, stripe, stripes, align, from, to)) {
+        std::cerr << "[Service] Data plane: streaming stripe " << stripe << " of " << path << " failed: " << std::strerror(errno)
+                  << std::endl;
+    }
+
+    close(fd);
+}
+
+bool DataPlaneServer::streamRange(int fd, const std::string& path, uint32_t stripe, uint32_t stripes, uint64_t align, uint64_t from, uint64_t to) {
+    int in = open(path.c_str(), O_RDONLY);
+    if (in < 0) return false;
+
+    struct stat st;
+    if (fstat(in, &st) != 0) {
+        close(in);
+        return false;
+    }
+
+    // Only [from, to) is wanted (a resumed transfer, one source's range); the stripes split that part
+    const uint64_t size = static_cast<uint64_t>(st.st_size);
+    to = (to == 0) ? size : std::min(to, size);
+    from = std::min(from, to);
+
+    DataPlaneHeader header;
+    stripeRange(to - from, stripes, stripe, align, header.offset, header.length);
+    header.offset += from;
+
+    uint8_t wire[DataPlaneHeader::kWireSize];
+    header.encode(wire);
+
+    const auto start = std::chrono::steady_clock::now();
+    bool ok = sendAll(fd, wire, sizeof(wire));
+
+    uint64_t sent = 0;
+#if defined(__linux__)
+    off_t off = static_cast<off_t>(header.offset);
+    while (ok && sent < header.length) {
+        ssize_t n = sendfile(fd, in, &off, static_cast<size_t>(header.length - sent));
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) {
+            ok = false;
+            break;
+        }
+        sent += static_cast<uint64_t>(n);
+    }
+#else
+    std::vector<uint8_t> buffer(1024 * 1024);
+    while (ok && sent < header.length) {
+        size_t want = static_cast<size_t>(std::min<uint64_t>(buffer.size(), header.length - sent));
+        ssize_t n = pread(in, buffer.data(), want, static_cast<off_t>(header.offset + sent));
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) {
+            ok = false;
+            break;
+        }
+        ok = sendAll(fd, buffer.data(), static_cast<size_t>(n));
+        sent += static_cast<uint64_t>(n);
+    }
+#endif
+
+    close(in);
+
+    if (ok) {
+        double secs = elapsedSeconds(start);
+        std::cout << "[Service] Data plane: stripe " << stripe + 1 << "/" << stripes << " streamed " << sent << " bytes of " << path
+                  << " in " << secs << " s ("
+                  << (secs > 0 ? sent / secs / (1024 * 1024) : 0) << " MB/s)" << std::endl;
+    }
+    return ok;
+}
+
+bool DataPlaneClient::receive(const std::string& endpoint, uint32_t stripes, size_t pieceSize, const Sink& sink, uint64_t idleTimeoutMs) {
+    std::string host, port;
+    uint64_t token = 0;
+    if (!parseEndpoint(endpoint, host, port, token)) {
+        std::cerr << "[Client] Invalid data plane endpoint: " << endpoint << std::endl;
+        return false;
+    }
+
+    stripes = std::max<uint32_t>(1, std::min<uint32_t>(stripes, kMaxStripes));
+    if (stripes == 1) return receiveStripe(host, port, token, 0, pieceSize, sink, idleTimeoutMs);
+
+    // Once one stripe fails the others stop at their next piece
+    std::atomic<bool> ok{true};
+    const Sink guarded = [&](uint64_t offset, const uint8_t* data, size_t size) { return ok && sink(offset, data, size); };
+    std::vector<std::thread> workers;
+    for (uint32_t i = 0; i < stripes; ++i) {
+        workers.emplace_back([&, i]() {
+            if (!receiveStripe(host, port, token, i, pieceSize, guarded, idleTimeoutMs)) ok = false;
+        });
+    }
+    for (auto& w : workers) w.join();
+
+    return ok;
+}
+
+bool DataPlaneClient::receiveStripe(const std::string& host, const std::string& port, uint64_t token, uint32_t stripe,
+                                    size_t pieceSize, const Sink& sink, uint64_t idleTimeoutMs) {
+    int fd = connectTo(host, port);
+    if (fd < 0) {
+        std::cerr << "[Client] Cannot connect to data plane " << host << ":" << port << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    if (idleTimeoutMs > 0) {
+        timeval tv{static_cast<time_t>(idleTimeoutMs / 1000), static_cast<suseconds_t>((idleTimeoutMs % 1000) * 1000)};
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    }
+
+    uint8_t hello[12];
+    putBe64(hello, token);
+    putBe32(hello + 8, stripe);
+
+    uint8_t wire[DataPlaneHeader::kWireSize];
+    DataPlaneHeader header;
+    if (!sendAll(fd, hello, sizeof(hello)) || !recvAll(fd, wire, sizeof(wire)) || !header.decode(wire)) {
+        std::cerr << "[Client] Data plane handshake failed for stripe " << stripe << std::endl;
+        close(fd);
+        return false;
+    }
+
+    std::vector<uint8_t> piece(pieceSize);
+    uint64_t done = 0;
+    bool ok = true;
+
+    while (done < header.length) {
+        size_t want = static_cast<size_t>(std::min<uint64_t>(header.length - done, piece.size()));
+        if (!recvAll(fd, piece.data(), want)) {
+            const bool timedOut = errno == EAGAIN || errno == EWOULDBLOCK;
+            std::cerr << "[Client] Data plane stripe " << stripe << (timedOut ? " timed out, " : " ended early, ") << (header.length - done)
+                      << " bytes missing" << std::endl;
+            ok = false;
+            break;
+        }
+        if (!sink(header.offset + done, piece.data(), want)) {
+            ok = false;
+            break;
+        }
+        done += want;
+    }
+
+    close(fd);
+    return ok;
+}
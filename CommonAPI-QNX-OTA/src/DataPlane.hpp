@@ -0,0 +1,94 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Out-of-band bulk data plane. SOME/IP stays the control plane: startSession
+// hands out an endpoint "tcp://<host>:<port>/<token>" and a stripe count N.
+// The client opens N connections, each sending the 8-byte token and its
+// 4-byte stripe index; the server answers each with a DataPlaneHeader and the
+// raw bytes of that stripe (sendfile on Linux, pread+send elsewhere). Stripes
+// are contiguous, chunk-aligned ranges, reassembled by offset on the client.
+
+static const uint32_t kDataPlaneMagic = 0x46544450;  // "FTDP"
+static const uint32_t kMaxStripes = 16;
+
+struct DataPlaneHeader {
+    uint32_t magic = kDataPlaneMagic;
+    uint32_t flags = 0;
+    uint64_t offset = 0;  // first image byte carried by this stream
+    uint64_t length = 0;  // number of bytes that follow the header
+
+    static const size_t kWireSize = 24;
+
+    void encode(uint8_t* out) const;
+    bool decode(const uint8_t* in);
+};
+
+class DataPlaneServer {
+   public:
+    DataPlaneServer(const std::string& advertiseHost, uint16_t port);
+    ~DataPlaneServer();
+
+    // Binds the listening socket and starts accepting connections
+    bool start();
+
+    // Registers a pending stream of bytes [from, to) of `path` (0: to the
+    // end), split into `stripes` ranges aligned to `align` bytes, and returns
+    // the endpoint to hand to the client. A resumed transfer starts at
+    // `from`; a multi-source client asks each gateway for its own range.
+    std::string offer(const std::string& path, uint32_t stripes, uint64_t align, uint64_t from = 0, uint64_t to = 0);
+
+   private:
+    struct Pending {
+        std::string path;
+        uint32_t stripes;
+        uint64_t align;
+        uint64_t from;
+        uint64_t to;
+        std::vector<bool> claimed;
+        uint32_t remaining;
+        std::chrono::steady_clock::time_point expires;
+    };
+
+    void acceptLoop();
+    void serve(int fd);
+    bool streamRange(int fd, const std::string& path, uint32_t stripe, uint32_t stripes, uint64_t align, uint64_t from, uint64_t to);
+
+    std::string host_;
+    uint16_t port_;
+    int listenFd_ = -1;
+    std::atomic<bool> running_{false};
+    std::thread acceptThread_;
+
+    std::mutex mutex_;
+    std::map<uint64_t, Pending> pending_;
+    std::mt19937_64 rng_;
+};
+
+class DataPlaneClient {
+   public:
+    // Receives payload pieces at their image offset. With several stripes it
+    // is called concurrently from one thread per stripe. Returning false
+    // (the piece could not be stored) aborts every stripe.
+    typedef std::function<bool(uint64_t offset, const uint8_t* data, size_t size)> Sink;
+
+    // Opens one connection per stripe and pulls every stripe into `sink`.
+    // A stripe that receives nothing for `idleTimeoutMs` fails (0: waits forever).
+    static bool receive(const std::string& endpoint, uint32_t stripes, size_t pieceSize, const Sink& sink, uint64_t idleTimeoutMs = 0);
+
+   private:
+    static bool receiveStripe(const std::string& host, const std::string& port, uint64_t token, uint32_t stripe,
+                              size_t pieceSize, const Sink& sink, uint64_t idleTimeoutMs);
+};
+
+// Byte range [offset, offset + length) of `stripe` out of `stripes` for an image of `size` bytes
+void stripeRange(uint64_t size, uint32_t stripes, uint32_t stripe, uint64_t align, uint64_t& offset, uint64_t& length);
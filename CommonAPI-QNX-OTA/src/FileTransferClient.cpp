@@ -1,22 +1,51 @@
+#include <fcntl.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>  // mkdir()
 
 #include <CommonAPI/CommonAPI.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cerrno>
 #include <chrono>
+#include <condition_variable>
 #include <cstdint>
 #include <fstream>
+#include <cstring>
+#include <functional>
+#include <future>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <thread>
+#include <vector>
 #include <v0/filetransfer/example/FileTransferProxy.hpp>
 
+#include "ChunkPipeline.hpp"
+#include "DataPlane.hpp"
+#include "ImageWriter.hpp"
+#include "IniConfig.hpp"
+#include "ProgressReporter.hpp"
+#include "RangeScheduler.hpp"
+#include "ResumeState.hpp"
+#include "ShmRing.hpp"
+#include "SlotInstaller.hpp"
+#include "StreamVerifier.hpp"
+#include "ota/Checksum.hpp"
+
 namespace ft = v0::filetransfer::example;
 
-static const size_t CHUNK_SIZE = 64 * 1024;  // 64KB
-static size_t UPDATE_SIZE = 0;
-ft::FileTransfer::UpdateInfo info;
+static const size_t CHUNK_SIZE = 64 * 1024;  // 64KB, used when the server does not announce its chunk size
+static const unsigned IDLE_REACK_MS = 2000;   // re-ack after this long without chunks, so dropped ones are resent
+static const unsigned IDLE_CHECK_MS = 500;    // how often the event path checks idle_timeout_ms
+static const unsigned SOURCE_WAIT_MS = 2000;  // how long further sources get to show up once the first one is there
+
+uint64_t elapsedNs(std::chrono::steady_clock::time_point start) {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+}
 
 // helper to create directory if missing
 void ensureClientDir() {
@@ -58,69 +87,735 @@ bool readUint32FromFile(const std::string& path, uint32_t& valueOut) {
 
 class FileReceiver {
    public:
-    FileReceiver(const std::string& outputName) : outPath_("data/client/" + outputName) {
+    // Reports the contiguous watermark (chunks [0, nextChunk) are on disk) to the server
+    typedef std::function<void(uint32_t sessionId, uint32_t nextChunk)> AckHandler;
+
+    // Reports the outcome of the integrity check back to the server
+    typedef std::function<void(uint32_t sessionId, bool verified, uint32_t crc, const std::string& sha256)> VerifyHandler;
+
+    // Runs once the image has been verified and flushed; returning false fails the update
+    typedef std::function<bool()> CommitHandler;
+
+    // Event path: runs on the writer thread once the transfer is over, after the final ack went out
+    typedef std::function<void(bool verified)> CompletionHandler;
+
+    // `inPlace` writes into an existing partition (or stand-in file) without
+    // truncating or renaming it. `writeQueueBytes` bounds the chunks received
+    // but not yet written to disk. `writeBackend` and `writeBuffer` select
+    // the ImageWriter once the image size is known.
+    FileReceiver(const std::string& outPath, bool inPlace, uint64_t writeQueueBytes, const std::string& writeBackend, size_t writeBuffer)
+        : outPath_(outPath), inPlace_(inPlace), writeBackend_(writeBackend), writeBuffer_(writeBuffer), writeQueueBytes_(writeQueueBytes) {
         ensureClientDir();
+    }
+
+    ~FileReceiver() {
+        stop_ = true;
+        wakeWriter();
+        if (writer_.joinable()) writer_.join();
+        pipeline_.reset();
+
+        // Interrupted (timeout, lost data plane): keep what arrived for the next run
+        if (resume_ && image_) resume_->checkpoint([this] { return image_->flush(); });
+    }
+
+    // Keeps the resume state in `statePath`, checkpointed every
+    // `checkpointBytes` written; call before expectImage()
+    void enableResume(const std::string& statePath, uint64_t checkpointBytes) {
+        resume_.reset(new ResumeState(statePath));
+        checkpointBytes_ = std::max<uint64_t>(checkpointBytes, 1);
+    }
+
+    // Expected image from UpdateInfo; opens the output sized for it, and the
+    // hashes are computed while it is written
+    void expectImage(uint64_t size, uint32_t crc, const std::string& sha256, VerifyHandler handler) {
+        imageSize_ = size;
+        if (progress_) progress_->setTotal(size);
 
-        ofs_.open(outPath_.c_str(), std::ios::binary);
-        if (!ofs_) {
+        expectedCrc_ = crc;
+        expectedSha256_ = sha256;
+        std::transform(expectedSha256_.begin(), expectedSha256_.end(), expectedSha256_.begin(), ::tolower);
+        verify_ = std::move(handler);
+
+        // A partial image is only picked up again for the very same image and output
+        bool resuming = false;
+        if (resume_ && (size == 0 || (crc == 0 && expectedSha256_.empty()))) {
+            std::cout << "[Client] Image size or checksum unknown, download is not resumable" << std::endl;
+            resume_.reset();
+        } else if (resume_) {
+            identity_.size = size;
+            identity_.crc = crc;
+            identity_.sha256 = expectedSha256_;
+            identity_.output = outPath_;
+            resuming = resume_->load(identity_);
+            if (!resuming) resume_->reset(identity_, 0);
+        }
+
+        image_ = ImageWriter::open(outPath_, inPlace_ || resuming, size, writeBackend_, writeBuffer_);
+        if (!image_ && resuming && !inPlace_) {
+            std::cout << "[Client] Partial image " << outPath_ << " is gone, starting over" << std::endl;
+            resuming = false;
+            resume_->reset(identity_, 0);
+            image_ = ImageWriter::open(outPath_, false, size, writeBackend_, writeBuffer_);
+        }
+        if (!image_) {
             std::cerr << "[Client] Failed to open output file: " << outPath_ << std::endl;
+            return;
         }
+        std::cout << "[Client] Writing " << outPath_ << " (" << image_->backendName() << ")" << std::endl;
+
+        ImageWriter* image = image_.get();
+        verifier_.reset(new StreamVerifier(size, [image](uint64_t offset, uint8_t* data, size_t n) { return image->read(offset, data, n); }));
+
+        if (resuming) validateResume();
     }
 
-    void onChunk(uint32_t index, const CommonAPI::ByteBuffer& data, bool lastChunk) {
-        if (!ofs_) {
-            std::cerr << "[Client] Output file not open. Cannot write chunk " << index << std::endl;
-            return;
+    // Bytes [0, resumeOffset()) are already on disk and checked; the server
+    // only has to send what follows
+    uint64_t resumeOffset() const { return resumeOffset_; }
+
+    // The session's chunk size, for either data path. Resume units follow
+    // it; call once the session is granted, before any data arrives.
+    void setChunkSize(size_t chunkSize) {
+        chunkSize_ = chunkSize;
+        if (!resume_ || !image_ || resume_->unitSize() == chunkSize) return;
+
+        // First session for this image, or the server changed its chunk size:
+        // the units of the checked prefix are recomputed in the new size
+        resume_->reset(identity_, static_cast<uint32_t>(chunkSize));
+        std::vector<uint8_t> buf(chunkSize);
+        uint32_t unit = 0;
+        for (uint64_t offset = 0; offset < resumeOffset_; offset += chunkSize, ++unit) {
+            const size_t n = static_cast<size_t>(std::min<uint64_t>(chunkSize, imageSize_ - offset));
+            if (offset + n > resumeOffset_ || !image_->read(offset, buf.data(), n)) break;
+            resume_->mark(unit, ResumeState::unitCrc(buf.data(), n));
         }
+    }
+
+    void setCommitHandler(CommitHandler handler) { commit_ = std::move(handler); }
 
-        double progress = (static_cast<double>(index * CHUNK_SIZE) / static_cast<double>(info.getSize())) * 100.0;
+    // Receives every committed byte and the verification phases; call before expectImage()
+    void setProgress(ProgressReporter* progress) { progress_ = progress; }
 
-        std::cout << "\r[Client] Downloading " << static_cast<int>(progress) << "%" << std::flush;
+    // Call before setSession()
+    void setCompletionHandler(CompletionHandler handler) { completed_ = std::move(handler); }
 
-        ofs_.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    // Call before setSession(); acks are sent from the writer thread
+    void setAckHandler(AckHandler handler, uint32_t interval) {
+        ack_ = std::move(handler);
+        ackInterval_ = std::max<uint32_t>(interval, 1);
+    }
 
-        if (lastChunk) {
-            std::cout << std::endl << "[Client] All chunks received. File saved to: " << outPath_ << std::endl;
-            ofs_.close();
+    // Threads checking event-path chunks between the dispatch thread and the
+    // writer; 0 checks them on the writer. Call before setSession().
+    void setCheckThreads(unsigned threads) { checkThreads_ = threads; }
+
+    // Binds the receiver to the session granted by startSession and starts
+    // the writer thread; call after setChunkSize(). Chunks that raced ahead
+    // of the reply were parked and are queued now.
+    void setSession(uint32_t sessionId) {
+        std::lock_guard<std::mutex> lock(earlyMutex_);
+
+        // The image size fixes the chunk count up front; without it the last chunk tells
+        if (imageSize_ > 0) chunkCount_ = static_cast<uint32_t>((imageSize_ + chunkSize_ - 1) / chunkSize_);
+        have_.assign(chunkCount_, false);
+
+        // The server starts after the resumed chunks, and so do the acks
+        const uint32_t resumed = static_cast<uint32_t>(resumeOffset_ / chunkSize_);
+        for (uint32_t i = 0; i < resumed; ++i) have_[i] = true;
+        haveCount_ = nextChunk_ = lastAck_ = resumed;
+        watermark_ = resumed;
+
+        // The CRC32 of each chunk serves the resume state and is chained into the image CRC
+        pipeline_.reset(new ChunkPipeline<QueuedChunk>(
+            checkThreads_, writeQueueBytes_ / chunkSize_ + 1,
+            [](QueuedChunk& c) {
+                Crc32 crc;
+                crc.update(c.data.data(), c.data.size());
+                c.crc = crc.value();
+            },
+            [this] { wakeWriter(); }));
+        stageStart_ = std::chrono::steady_clock::now();
+
+        std::vector<EarlyChunk> early;
+        early.swap(early_);
+        for (EarlyChunk& c : early) {
+            if (c.sessionId == sessionId) enqueue(c.index, std::move(c.data), c.last);
+        }
+
+        // From here on the dispatch thread queues directly; the writer drains whatever is there
+        sessionId_ = sessionId;
+        writer_ = std::thread(&FileReceiver::writeLoop, this);
+    }
+
+    // Runs on the CommonAPI dispatch thread, the queue's only producer. It
+    // never touches the disk: chunks are copied into the write queue, and
+    // when the queue is full they are dropped rather than stalling dispatch.
+    // The check threads take them from there and the writer gets them back
+    // in arrival order.
+    // A dropped chunk holds back the acked watermark. The first drop of a
+    // burst acks that watermark again at once, and the writer keeps
+    // repeating it for chunks above the gap; the server takes the duplicate
+    // acks as a loss and resends from the gap.
+    void onChunk(uint32_t sessionId, uint32_t index, const CommonAPI::ByteBuffer& data, bool lastChunk) {
+        if (complete_) return;
+
+        uint32_t current = sessionId_;
+        if (current == 0) {
+            std::lock_guard<std::mutex> lock(earlyMutex_);
+            current = sessionId_;
+            if (current == 0) {
+                early_.push_back(EarlyChunk{sessionId, index, data, lastChunk});
+                return;
+            }
+        }
+        if (sessionId != current) return;  // another client's session
+
+        const auto start = std::chrono::steady_clock::now();
+        enqueue(index, CommonAPI::ByteBuffer(data), lastChunk);
+        receiveNs_ += elapsedNs(start);
+    }
+
+    // Re-announces the watermark, e.g. when the server comes back after a restart
+    void reack() {
+        reackRequested_ = true;
+        wakeWriter();
+    }
+
+    // Data plane entry point: payload is written at its image offset straight
+    // from the transport's buffer. Safe to call from several stripe threads.
+    bool writeAt(uint64_t offset, const uint8_t* data, size_t size) { return store(offset, data, size, nullptr); }
+
+    // Returns false if the image failed verification
+    bool finish() {
+        if (!image_) return false;
+
+        if (progress_) progress_->setPhase(ProgressReporter::Phase::Verifying);
+        std::cout << std::endl << "[Client] All chunks received. " << (inPlace_ ? "Written to: " : "File saved to: ") << outPath_ << std::endl;
+
+        if (progress_) {
+            ProgressReporter::Snapshot p = progress_->snapshot();
+            const uint64_t received = p.bytes - resumeOffset_;
+            std::cout << "[Client] Received " << received << " bytes in " << p.elapsedSeconds << " s ("
+                      << (p.elapsedSeconds > 0 ? received / p.elapsedSeconds / (1024 * 1024) : 0) << " MB/s)";
+            if (resumeOffset_ > 0) std::cout << ", " << resumeOffset_ << " resumed";
+            std::cout << std::endl;
         }
+        if (duplicates_ > 0) std::cout << "[Client] Ignored " << duplicates_ << " duplicate chunk(s)" << std::endl;
+        if (queueDrops_ > 0)
+            std::cout << "[Client] Write queue was full " << queueDrops_ << " time(s), peak " << (peakQueuedBytes_.load() >> 10) << " KB" << std::endl;
+        if (pipeline_) reportStages();
+
+        // Buffered extents go out first; a commit must only see durable data
+        bool flushed = image_->flush();
+        if (!flushed) std::cerr << "[Client] Flushing " << outPath_ << " failed" << std::endl;
+
+        bool verified = verify(flushed);
+        if (progress_) progress_->setPhase(verified ? ProgressReporter::Phase::Done : ProgressReporter::Phase::Failed);
+
+        // Nothing left to resume either way: the image is complete, or bad and set aside
+        if (resume_) {
+            resume_->remove();
+            resume_.reset();
+        }
+
+        // Keep a corrupt image where nothing will pick it up as an update
+        if (!verified && inPlace_)
+            std::cerr << "[Client] " << outPath_ << " stays inactive, boot config unchanged" << std::endl;
+        else if (!verified && rename(outPath_.c_str(), (outPath_ + ".corrupt").c_str()) == 0)
+            std::cerr << "[Client] Moved corrupt image to " << outPath_ << ".corrupt" << std::endl;
+        return verified;
     }
 
    private:
+    // Writes a piece and feeds the verifier and the resume state; `crc` is
+    // the piece's CRC32 if a check thread computed it already
+    bool store(uint64_t offset, const uint8_t* data, size_t size, const uint32_t* crc) {
+        if (!image_) return false;
+
+        // Checked on disk already (the shared-memory ring always sends the whole image)
+        if (offset + size <= resumeOffset_) return true;
+
+        if (!image_->write(offset, data, size)) {
+            std::cerr << std::endl << "[Client] Write failed at offset " << offset << std::endl;
+            return false;
+        }
+
+        if (verifier_) {
+            const auto start = std::chrono::steady_clock::now();
+            if (crc) verifier_->onWritten(offset, data, size, *crc);
+            else verifier_->onWritten(offset, data, size);
+            hashNs_ += elapsedNs(start);
+        }
+        if (progress_) progress_->add(size);
+        if (resume_) track(offset, data, size, crc);
+        return true;
+    }
+
+    // How busy each event-path stage was since the session started; the
+    // one close to 100% is what holds the transfer back
+    void reportStages() {
+        const double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - stageStart_).count();
+        if (wall <= 0) return;
+        const auto percent = [wall](double busy) { return static_cast<int>(100.0 * busy / wall + 0.5); };
+
+        const ChunkPipeline<QueuedChunk>::Stats check = pipeline_->stats();
+        const double hash = static_cast<double>(hashNs_.load()) / 1e9;
+        std::cout << "[Client] Stage utilization over " << wall << " s: receive " << percent(static_cast<double>(receiveNs_.load()) / 1e9)
+                  << "%, check ";
+        if (check.workers > 0) std::cout << check.workers << " x " << percent(check.busySeconds / check.workers) << "%";
+        else std::cout << percent(check.busySeconds) << "% on the writer";
+        std::cout << ", write " << percent(static_cast<double>(writerNs_.load()) / 1e9 - hash) << "%, hash " << percent(hash) << "%" << std::endl;
+    }
+
+    // Checks the units listed in the resume state against the bytes on disk,
+    // in image order. The run of good units from the start is kept and fed
+    // to the verifier; everything after it is received again.
+    void validateResume() {
+        const auto start = std::chrono::steady_clock::now();
+        const uint32_t unitSize = resume_->unitSize();
+        std::vector<uint8_t> buf(unitSize);
+
+        uint32_t unit = 0;
+        uint32_t crc = 0;
+        uint64_t offset = 0;
+        while (unitSize != 0 && offset < imageSize_ && resume_->get(unit, crc)) {
+            const size_t n = static_cast<size_t>(std::min<uint64_t>(unitSize, imageSize_ - offset));
+            if (!image_->read(offset, buf.data(), n) || ResumeState::unitCrc(buf.data(), n) != crc) break;
+            verifier_->onWritten(offset, buf.data(), n);
+            offset += n;
+            ++unit;
+        }
+        resume_->truncate(unit);
+        resumeOffset_ = offset;
+        if (progress_) progress_->addResumed(offset);
+
+        const double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "[Client] Resuming " << outPath_ << " at " << offset << " of " << imageSize_ << " bytes (" << unit
+                  << " chunk(s) checked in " << secs << " s)" << std::endl;
+    }
+
+    // Records whole units for the resume state and checkpoints it every
+    // checkpointBytes_. Stripe threads that find a checkpoint running go on.
+    void track(uint64_t offset, const uint8_t* data, size_t size, const uint32_t* crc) {
+        const uint32_t unitSize = resume_->unitSize();
+        if (unitSize != 0 && offset % unitSize == 0 && (size == unitSize || offset + size == imageSize_))
+            resume_->mark(static_cast<uint32_t>(offset / unitSize), crc ? *crc : ResumeState::unitCrc(data, size));
+
+        if (sinceCheckpoint_.fetch_add(size) + size < checkpointBytes_) return;
+        std::unique_lock<std::mutex> lock(checkpointMutex_, std::try_to_lock);
+        if (!lock.owns_lock()) return;
+        sinceCheckpoint_ = 0;
+        resume_->checkpoint([this] { return image_->flush(); });
+    }
+
+    bool verify(bool flushed) {
+        if (!verifier_) return flushed;
+
+        StreamVerifier::Result r = verifier_->finish();
+        std::cout << "[Client] CRC32 0x" << std::hex << r.crc << std::dec << ", SHA-256 " << r.sha256 << " (" << r.rereadBytes
+                  << " bytes read back)" << std::endl;
+
+        bool verified = r.complete && flushed;
+        if (!r.complete) std::cerr << "[Client] Verification incomplete: image has gaps" << std::endl;
+        if (expectedCrc_ != 0 && r.crc != expectedCrc_) {
+            std::cerr << "[Client] CRC32 mismatch: expected 0x" << std::hex << expectedCrc_ << std::dec << std::endl;
+            verified = false;
+        }
+        if (!expectedSha256_.empty() && r.sha256 != expectedSha256_) {
+            std::cerr << "[Client] SHA-256 mismatch: expected " << expectedSha256_ << std::endl;
+            verified = false;
+        }
+        if (expectedCrc_ == 0 && expectedSha256_.empty()) std::cout << "[Client] Server published no checksum, image not verified" << std::endl;
+        else if (verified) std::cout << "[Client] Image verified" << std::endl;
+
+        if (verified && commit_) verified = commit_();
+
+        if (verify_) verify_(sessionId_, verified, r.crc, r.sha256);
+        return verified;
+    }
+
+    struct EarlyChunk {
+        uint32_t sessionId;
+        uint32_t index;
+        CommonAPI::ByteBuffer data;
+        bool last;
+    };
+
+    struct QueuedChunk {
+        uint32_t index = 0;
+        CommonAPI::ByteBuffer data;
+        bool last = false;
+        uint32_t crc = 0;  // of data, set by the check stage
+    };
+
+    // Producer side of the write queue
+    void enqueue(uint32_t index, CommonAPI::ByteBuffer&& data, bool last) {
+        const size_t size = data.size();
+        const uint64_t queued = queuedBytes_.load(std::memory_order_relaxed);
+
+        if (queued + size > writeQueueBytes_ || !pipeline_->push(QueuedChunk{index, std::move(data), last, 0})) {
+            if (queueDrops_++ == 0)
+                std::cerr << std::endl << "[Client] Write queue full (" << (queued >> 10) << " KB), dropping chunks until the disk catches up" << std::endl;
+
+            // The writer may be stuck in a flush for longer than the server's stall period, so the
+            // duplicate ack goes out from here; the writer repeats it once it has drained the queue
+            if (!dropping_.exchange(true) && ack_ && sessionId_ != 0) ack_(sessionId_, watermark_);
+            reackRequested_ = true;
+            return;
+        }
+
+        dropping_ = false;
+        queuedBytes_.fetch_add(size);
+        if (queued + size > peakQueuedBytes_.load(std::memory_order_relaxed)) peakQueuedBytes_.store(queued + size, std::memory_order_relaxed);
+        wakeWriter();
+    }
+
+    void wakeWriter() {
+        // Pairs with the fence in writeLoop: either the writer sees the new
+        // work before sleeping, or this side sees it idle and notifies
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!writerIdle_.load()) return;
+        { std::lock_guard<std::mutex> lock(wakeMutex_); }
+        wake_.notify_one();
+    }
+
+    // Writer thread: the only one that writes event-path chunks and sends their acks
+    void writeLoop() {
+        QueuedChunk c;
+
+        // Resumed with every chunk already on disk: nothing is going to arrive
+        if (chunkCount_ != 0 && haveCount_ == chunkCount_) complete();
+
+        while (!stop_ && !complete_) {
+            if (pipeline_->pop(c)) {
+                const auto start = std::chrono::steady_clock::now();
+                const size_t size = c.data.size();
+                handleChunk(c);
+                c.data = CommonAPI::ByteBuffer();
+                queuedBytes_.fetch_sub(size);
+                writerNs_ += elapsedNs(start);
+                continue;
+            }
+
+            if (reackRequested_.exchange(false)) {
+                sendAck();
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(wakeMutex_);
+            writerIdle_ = true;
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            bool woken = wake_.wait_for(lock, std::chrono::milliseconds(IDLE_REACK_MS),
+                                        [&] { return stop_ || reackRequested_ || pipeline_->ready(); });
+            writerIdle_ = false;
+
+            // Nothing arrived for a while: if chunks were dropped or lost, the ack asks for them again
+            if (!woken) sendAck();
+        }
+    }
+
+    // Chunks may arrive in any order and more than once (striping, resends,
+    // a resumed stream). Each is written at its own offset the first time it
+    // is seen; the transfer is complete once every bit of the map is set.
+    // Called on the writer thread only.
+    void handleChunk(const QueuedChunk& c) {
+        const uint32_t index = c.index;
+        const bool lastChunk = c.last;
+        if (complete_) return;
+
+        if (chunkCount_ != 0 && index >= chunkCount_) {
+            std::cerr << std::endl << "[Client] Dropping chunk " << index << " beyond the image end" << std::endl;
+            return;
+        }
+        if (index >= have_.size()) have_.resize(index + 1, false);
+        if (have_[index]) {
+            ++duplicates_;
+            return;
+        }
+
+        // A failed write leaves the bit clear, so the chunk is requested again
+        if (!store(static_cast<uint64_t>(index) * chunkSize_, c.data.data(), c.data.size(), &c.crc)) return;
+        have_[index] = true;
+        ++haveCount_;
+        ++sinceAck_;
+
+        while (nextChunk_ < have_.size() && have_[nextChunk_]) ++nextChunk_;
+        watermark_ = nextChunk_;
+        if (lastChunk && chunkCount_ == 0) chunkCount_ = index + 1;
+
+        // A chunk above a gap announces the watermark at once, then repeats it every ack_interval
+        // chunks; the server resends from the gap on duplicate acks. After the last chunk, an ack
+        // below the end asks for the gap as well.
+        const bool aboveGap = index > nextChunk_ && (nextChunk_ != lastAck_ || sinceAck_ >= ackInterval_);
+
+        if (chunkCount_ != 0 && haveCount_ == chunkCount_) {
+            complete();
+        } else if (lastChunk || aboveGap || nextChunk_ - lastAck_ >= ackInterval_) {
+            sendAck();
+        }
+    }
+
+    // Writer thread: acks the current watermark, which repeats the last ack if it has not moved
+    void sendAck() {
+        lastAck_ = nextChunk_;
+        sinceAck_ = 0;
+        if (ack_) ack_(sessionId_, nextChunk_);
+    }
+
+    // Writer thread: verifies, then sends the final ack that closes the session
+    void complete() {
+        complete_ = true;
+        bool verified = finish();
+        if (ack_) ack_(sessionId_, chunkCount_);
+        if (completed_) completed_(verified);
+    }
+
     std::string outPath_;
-    std::ofstream ofs_;
+    bool inPlace_;
+    std::string writeBackend_;
+    size_t writeBuffer_;
+    std::unique_ptr<ImageWriter> image_;
+    uint64_t imageSize_ = 0;  // 0 if the server did not announce it
+    CommitHandler commit_;
+    ProgressReporter* progress_ = nullptr;
+
+    std::unique_ptr<ResumeState> resume_;  // null when resuming is off
+    ResumeState::Identity identity_;
+    uint64_t resumeOffset_ = 0;  // bytes [0, resumeOffset_) were checked on disk from an earlier run
+    uint64_t checkpointBytes_ = 0;
+    std::atomic<uint64_t> sinceCheckpoint_{0};
+    std::mutex checkpointMutex_;  // one checkpoint at a time
+
+    std::unique_ptr<StreamVerifier> verifier_;
+    uint32_t expectedCrc_ = 0;
+    std::string expectedSha256_;
+    VerifyHandler verify_;
+
+    std::mutex earlyMutex_;  // guards early_ until the session is known
+    std::atomic<uint32_t> sessionId_{0};
+    size_t chunkSize_ = CHUNK_SIZE;
+    std::vector<EarlyChunk> early_;
+
+    // Write queue from the dispatch thread to writer_
+    uint64_t writeQueueBytes_;
+    unsigned checkThreads_ = 0;
+    std::unique_ptr<ChunkPipeline<QueuedChunk>> pipeline_;
+    std::atomic<uint64_t> queuedBytes_{0};
+    std::atomic<uint64_t> peakQueuedBytes_{0};
+    std::atomic<uint64_t> queueDrops_{0};
+    std::thread writer_;
+    std::mutex wakeMutex_;
+    std::condition_variable wake_;
+    std::atomic<bool> writerIdle_{false};
+    std::atomic<bool> reackRequested_{false};
+    std::atomic<bool> dropping_{false};    // chunks are being dropped; the burst has been acked
+    std::atomic<uint32_t> watermark_{0};   // nextChunk_, for acks sent from the dispatch thread
+    std::atomic<bool> stop_{false};
+
+    // Time spent per stage, for the utilization report
+    std::chrono::steady_clock::time_point stageStart_;
+    std::atomic<uint64_t> receiveNs_{0};
+    std::atomic<uint64_t> writerNs_{0};
+    std::atomic<uint64_t> hashNs_{0};
+
+    // Writer thread state
+    std::vector<bool> have_;   // one bit per chunk already on disk
+    uint32_t haveCount_ = 0;
+    uint64_t duplicates_ = 0;
+    uint32_t nextChunk_ = 0;   // first chunk not yet on disk
+    uint32_t chunkCount_ = 0;  // from the image size, else known once the last chunk arrived
+    uint32_t lastAck_ = 0;
+    uint32_t sinceAck_ = 0;   // chunks written since the last ack
+    std::atomic<bool> complete_{false};
+    AckHandler ack_;
+    uint32_t ackInterval_ = 8;
+    CompletionHandler completed_;
 };
 
-int main() {
+// Resolves on the first AVAILABLE status; CommonAPI reports the current
+// availability right after subscribing, so an already running gateway is
+// seen at once and a later one as soon as its offer arrives.
+bool waitForService(ft::FileTransferProxy<>& proxy, std::chrono::milliseconds timeout) {
+    // Shared with the handler, which may still be running when this returns
+    struct State {
+        std::promise<void> available;
+        std::atomic<bool> seen{false};
+    };
+    auto state = std::make_shared<State>();
+    std::future<void> ready = state->available.get_future();
+
+    auto subscription = proxy.getProxyStatusEvent().subscribe([state](const CommonAPI::AvailabilityStatus& status) {
+        if (status == CommonAPI::AvailabilityStatus::AVAILABLE && !state->seen.exchange(true)) state->available.set_value();
+    });
+    if (proxy.isAvailable() && !state->seen.exchange(true)) state->available.set_value();
+
+    if (ready.wait_for(std::chrono::seconds(0)) != std::future_status::ready) std::cout << "[Client] Waiting for service..." << std::endl;
+
+    bool ok = true;
+    if (timeout.count() > 0) ok = ready.wait_for(timeout) == std::future_status::ready;
+    else ready.wait();
+
+    proxy.getProxyStatusEvent().unsubscribe(subscription);
+    return ok;
+}
+
+// A further gateway serving the image, for multi-source downloads
+struct Source {
+    std::string instance;
+    std::shared_ptr<ft::FileTransferProxy<>> proxy;
+};
+
+// Connects to each instance in the comma-separated `instances` and keeps
+// those that offer the very same image as `info` and `sha256`
+std::vector<Source> findSources(const std::string& instances, uint32_t currentVersion, const ft::FileTransfer::UpdateInfo& info,
+                                const std::string& sha256, const CommonAPI::CallInfo& callInfo) {
+    std::vector<Source> found;
+    std::stringstream list(instances);
+    std::string instance;
+
+    while (std::getline(list, instance, ',')) {
+        instance.erase(std::remove_if(instance.begin(), instance.end(), ::isspace), instance.end());
+        if (instance.empty()) continue;
+
+        auto proxy = CommonAPI::Runtime::get()->buildProxy<ft::FileTransferProxy>("local", instance, "client-sample");
+        if (!proxy || !waitForService(*proxy, std::chrono::milliseconds(SOURCE_WAIT_MS))) {
+            std::cerr << "[Client] Source " << instance << " not available, skipping it" << std::endl;
+            continue;
+        }
+
+        CommonAPI::CallStatus status;
+        ft::FileTransfer::UpdateInfo offered;
+        std::string offeredSha256;
+        proxy->checkUpdate(currentVersion, status, offered, offeredSha256, &callInfo);
+        if (status != CommonAPI::CallStatus::SUCCESS || !offered.getExists() || offered.getSize() != info.getSize() ||
+            offered.getCrc() != info.getCrc() || offeredSha256 != sha256) {
+            std::cerr << "[Client] Source " << instance << " does not serve the same image, skipping it" << std::endl;
+            continue;
+        }
+        found.push_back(Source{instance, proxy});
+    }
+    return found;
+}
+
+// Replaces the client with ota-apply for a verified image in data/client/
+void handOff(const std::string& command, const std::string& image) {
+    std::cout << "[Client] Handing off to " << command << std::endl;
+    std::cout.flush();
+    execl(command.c_str(), command.c_str(), "--image", image.c_str(), static_cast<char*>(nullptr));
+    std::cerr << "[Client] Could not start " << command << ": " << std::strerror(errno) << std::endl;
+}
+
+// Runs one update check and, if there is a new image, the transfer. Returns
+// the exit code; `installedImage` is set to a verified image left in
+// data/client/ for ota-apply.
+int runClient(const IniConfig& config, std::string& installedImage) {
     std::string outputFilename = "qnx_uefi.iso";
 
     CommonAPI::Runtime::setProperty("LibraryBase", "FileTransfer");
     auto runtime = CommonAPI::Runtime::get();
 
-    std::shared_ptr<ft::FileTransferProxy<>> proxy;
+    // [transfer] instance is the gateway asked for updates; it must match the server's
+    const std::string instance = config.get("transfer", "instance", "filetransfer.example.FileTransfer");
+    std::shared_ptr<ft::FileTransferProxy<>> proxy = runtime->buildProxy<ft::FileTransferProxy>("local", instance, "client-sample");
+    if (!proxy) {
+        std::cerr << "[Client] Failed to build the FileTransfer proxy" << std::endl;
+        return 1;
+    }
+
+    // [transfer] service_timeout_ms bounds the wait for the gateway; 0 waits forever
+    if (!waitForService(*proxy, std::chrono::milliseconds(config.getUint("transfer", "service_timeout_ms", 30000)))) {
+        std::cerr << "[Client] Service not available, giving up" << std::endl;
+        return 1;
+    }
 
-    while (!proxy) {
-        proxy = runtime->buildProxy<ft::FileTransferProxy>("local", "filetransfer.example.FileTransfer", "client-sample");
+    // [transfer] call_timeout_ms bounds each blocking method call
+    const auto callTimeout = std::chrono::milliseconds(config.getUint("transfer", "call_timeout_ms", 5000));
+    const CommonAPI::CallInfo callInfo(static_cast<CommonAPI::Timeout_t>(callTimeout.count()));
 
-        if (!proxy->isAvailable()) {
-            std::cout << "[Client] Waiting for service..." << std::endl;
-            std::this_thread::sleep_for(std::chrono::seconds(1));
-        }
+    // [transfer] idle_timeout_ms gives up when no byte arrives for that long (e.g. the gateway never comes back); 0 disables.
+    // The event path checks it in the wait loop below, the data plane and the ring in their blocking receives.
+    const auto idleTimeout = std::chrono::milliseconds(config.getUint("transfer", "idle_timeout_ms", 60000));
+
+    // [transfer] write_queue bounds the chunks buffered ahead of a slow disk; the server is told to keep its window within it
+    const uint64_t writeQueueBytes = std::max<uint64_t>(config.getUint("transfer", "write_queue", 16 * 1024 * 1024), CHUNK_SIZE);
+
+    // [transfer] target=slot streams into the inactive A/B partition instead of data/client/
+    const bool toSlot = (config.get("transfer", "target", "file") == "slot");
+    SlotInstaller slot;
+    if (toSlot) {
+        // The slot_* keys and bootconf let a file or loop device stand in for the partitions
+        SlotInstaller::Config slotConfig;
+        slotConfig.cmdlinePath = config.get("transfer", "slot_cmdline", slotConfig.cmdlinePath);
+        slotConfig.bootconfPath = config.get("transfer", "bootconf", slotConfig.bootconfPath);
+        slotConfig.layout.devA = config.get("transfer", "slot_a", slotConfig.layout.devA);
+        slotConfig.layout.devB = config.get("transfer", "slot_b", slotConfig.layout.devB);
+        if (!slot.prepare(slotConfig)) return 1;
     }
 
-    FileReceiver receiver(outputFilename);
+    // [transfer] progress_socket is where the GUI connects for progress_hz updates; empty disables it.
+    // Declared before the receiver, whose writer thread reports into it until it is joined.
+    ProgressReporter::Config progressConfig;
+    progressConfig.socketPath = config.get("transfer", "progress_socket", "/tmp/ota-progress.sock");
+    progressConfig.hz = static_cast<uint32_t>(config.getUint("transfer", "progress_hz", 10));
+    ProgressReporter progress(progressConfig);
+    progress.start();
+
+    // [transfer] write_backend picks how pieces reach the disk; write_buffer is the extent they are coalesced into
+    const std::string writeBackend = config.get("transfer", "write_backend", "auto");
+    const size_t writeBuffer = static_cast<size_t>(config.getUint("transfer", "write_buffer", 1024 * 1024));
+
+    // The final ack closes the session on the server; the last one sent is kept so the exit can wait for it.
+    // Declared before the receiver, whose writer thread keeps acking until it is joined.
+    std::mutex ackMutex;
+    std::future<CommonAPI::CallStatus> lastAck;
+
+    FileReceiver receiver(toSlot ? slot.targetDevice() : "data/client/" + outputFilename, toSlot, writeQueueBytes, writeBackend, writeBuffer);
+    receiver.setProgress(&progress);
 
-    proxy->getFileChunkEvent().subscribe(
-        [&](uint32_t index, const CommonAPI::ByteBuffer& data, bool last) { receiver.onChunk(index, data, last); });
+    // [transfer] resume_state keeps a partial download resumable across a power cut, checkpointed every
+    // resume_checkpoint bytes; empty disables it
+    const std::string resumeState = config.get("transfer", "resume_state", "data/client/resume.state");
+    if (!resumeState.empty()) receiver.enableResume(resumeState, config.getUint("transfer", "resume_checkpoint", 16 * 1024 * 1024));
+
+    // The boot flip happens only after the slot content has been verified
+    if (toSlot) receiver.setCommitHandler([&]() { return slot.commit(); });
+
+    // Both listeners below capture the receiver, so on every return they are
+    // unsubscribed before it is destroyed
+    struct Subscriptions {
+        ft::FileTransferProxy<>& proxy;
+        ft::FileTransferProxyBase::SessionChunkEvent::Subscription chunks = 0;
+        CommonAPI::ProxyStatusEvent::Subscription status = 0;
+        bool hasChunks = false;
+        bool hasStatus = false;
+
+        void dropChunks() {
+            if (hasChunks) proxy.getSessionChunkEvent().unsubscribe(chunks);
+            hasChunks = false;
+        }
+
+        ~Subscriptions() {
+            dropChunks();
+            if (hasStatus) proxy.getProxyStatusEvent().unsubscribe(status);
+        }
+    } subscriptions{*proxy};
+
+    const auto onChunk = [&](uint32_t sessionId, uint32_t index, const CommonAPI::ByteBuffer& data, bool last) {
+        receiver.onChunk(sessionId, index, data, last);
+    };
+    subscriptions.chunks = proxy->getSessionChunkEvent().subscribe(onChunk);
+    subscriptions.hasChunks = true;
 
     uint32_t currentVersion = 0;
     readUint32FromFile("data/client/update.version", currentVersion);
 
     CommonAPI::CallStatus status;
-    proxy->requestUpdate(currentVersion, status, info);
-    UPDATE_SIZE = info.getSize();
+    ft::FileTransfer::UpdateInfo info;
+    std::string sha256;
+    proxy->checkUpdate(currentVersion, status, info, sha256, &callInfo);
 
     if (status != CommonAPI::CallStatus::SUCCESS) {
-        std::cerr << "[Client] requestUpdate failed!" << std::endl;
+        std::cerr << "[Client] checkUpdate failed!" << std::endl;
         return 1;
     }
 
@@ -134,20 +829,224 @@ int main() {
         return 0;
     }
 
+    if (toSlot) {
+        if (!slot.fits(info.getSize())) return 1;
+        if (info.getCrc() == 0 && sha256.empty()) {
+            std::cerr << "[Client] Server published no checksum; refusing to write an unverifiable image into a slot" << std::endl;
+            return 1;
+        }
+    }
+
     std::cout << "[Client] New update available. Starting transfer..." << std::endl;
 
     std::cout << "[Client] Info - New Version: " << info.getNewVersion() << ", Size: " << info.getSize() << ", CRC: 0x" << std::hex
               << info.getCrc() << std::dec << ", Result Code: " << info.getResultCode() << std::endl;
 
+    // Verified on the fly; the outcome goes back to the server. Blocking, so
+    // it has been delivered by the time the transfer counts as complete.
+    receiver.expectImage(info.getSize(), info.getCrc(), sha256,
+                         [&](uint32_t sessionId, bool verified, uint32_t crc, const std::string& computed) {
+                             CommonAPI::CallStatus reportStatus;
+                             bool known = false;
+                             proxy->reportVerification(sessionId, verified, crc, computed, reportStatus, known, &callInfo);
+                             if (reportStatus != CommonAPI::CallStatus::SUCCESS)
+                                 std::cerr << "[Client] Could not report the verification result" << std::endl;
+                         });
+
+    // [transfer] dataplane=tcp asks the server for the out-of-band data plane
+    ft::FileTransfer::TransferRequest request;
+    request.setDataPlane(config.get("transfer", "dataplane", "events") == "tcp");
+
+    // Lets the server pick the shared-memory ring when it runs on this host
+    if (config.get("transfer", "shm", "auto") != "off") request.setHostId(localHostId());
+
+    // Number of parallel data plane connections to ask for
+    request.setStripes(static_cast<uint8_t>(config.getUint("transfer", "stripes", 1)));
+
+    // Stable identity so the server can tell a restarted transfer from a new client
+    char hostName[256] = {0};
+    gethostname(hostName, sizeof(hostName) - 1);
+    request.setClientId(config.get("transfer", "client_id", hostName));
+    request.setReceiveBuffer(static_cast<uint32_t>(std::min<uint64_t>(writeQueueBytes, UINT32_MAX)));
+    request.setResumeOffset(receiver.resumeOffset());
+
+    receiver.setAckHandler(
+        [&](uint32_t sessionId, uint32_t nextChunk) {
+            auto sent = proxy->ackChunksAsync(sessionId, nextChunk, [sessionId](const CommonAPI::CallStatus& callStatus, const bool& known) {
+                if (callStatus == CommonAPI::CallStatus::SUCCESS && !known)
+                    std::cerr << std::endl << "[Client] Server no longer knows session " << sessionId << std::endl;
+            });
+            std::lock_guard<std::mutex> lock(ackMutex);
+            lastAck = std::move(sent);
+        },
+        static_cast<uint32_t>(config.getUint("transfer", "ack_interval", 8)));
+
+    // After a gateway restart the service reappears; re-acking resumes the journaled session
+    subscriptions.status = proxy->getProxyStatusEvent().subscribe([&](const CommonAPI::AvailabilityStatus& availability) {
+        if (availability == CommonAPI::AvailabilityStatus::AVAILABLE) receiver.reack();
+    });
+    subscriptions.hasStatus = true;
+
+    // [transfer] sources lists further gateways with the same image; over the data plane the download is split between all of them
+    std::vector<Source> sources = findSources(config.get("transfer", "sources", ""), currentVersion, info, sha256, callInfo);
+    if (!sources.empty() && !request.getDataPlane()) {
+        std::cerr << "[Client] Multi-source download needs dataplane=tcp, using " << instance << " only" << std::endl;
+        sources.clear();
+    }
+
+    if (!sources.empty()) {
+        subscriptions.dropChunks();
+        sources.insert(sources.begin(), Source{instance, proxy});
+
+        // Segments and resume units are the client's chunk size, whatever each gateway uses
+        receiver.setChunkSize(CHUNK_SIZE);
+
+        // [transfer] segment_size caps the range one source is given at a time
+        RangeScheduler scheduler(receiver.resumeOffset(), info.getSize(), CHUNK_SIZE, config.getUint("transfer", "segment_size", 16 * 1024 * 1024));
+        for (const Source& source : sources) {
+            std::shared_ptr<ft::FileTransferProxy<>> sourceProxy = source.proxy;
+            scheduler.addSource(source.instance, [&, sourceProxy](uint64_t from, uint64_t to, const RangeScheduler::Sink& sink) {
+                ft::FileTransfer::TransferRequest range = request;
+                range.setHostId("");  // the shared-memory ring always carries the whole image
+                range.setResumeOffset(from);
+                range.setRangeEnd(to);
+
+                CommonAPI::CallStatus rangeStatus;
+                bool granted = false;
+                ft::FileTransfer::TransferSession rangeSession;
+                sourceProxy->startSession("qnx_uefi.iso", range, rangeStatus, granted, rangeSession, &callInfo);
+                if (rangeStatus != CommonAPI::CallStatus::SUCCESS || !granted || rangeSession.getDataEndpoint().compare(0, 6, "tcp://") != 0)
+                    return false;
+                return DataPlaneClient::receive(rangeSession.getDataEndpoint(), rangeSession.getStripes(), CHUNK_SIZE, sink, idleTimeout.count());
+            });
+        }
+
+        std::cout << "[Client] Downloading from " << sources.size() << " sources over the data plane" << std::endl;
+        bool ok = scheduler.run([&](uint64_t offset, const uint8_t* data, size_t size) { return receiver.writeAt(offset, data, size); });
+
+        for (const RangeScheduler::Stats& st : scheduler.stats()) {
+            std::cout << "[Client] Source " << st.name << ": " << (st.bytes >> 20) << " MB in " << st.segments << " segment(s), "
+                      << (st.busySeconds > 0 ? st.bytes / st.busySeconds / (1024 * 1024) : 0) << " MB/s" << (st.failed ? ", failed" : "")
+                      << std::endl;
+        }
+        if (!ok || !receiver.finish()) return 1;
+
+        if (!toSlot) installedImage = "data/client/" + outputFilename;
+        return 0;
+    }
+
     bool accepted = false;
-    proxy->startTransfer("qnx_uefi.iso", status, accepted);
+    ft::FileTransfer::TransferSession session;
+    proxy->startSession("qnx_uefi.iso", request, status, accepted, session, &callInfo);
 
-    if (!accepted) {
-        std::cerr << "[Client] startTransfer rejected!" << std::endl;
+    if (status != CommonAPI::CallStatus::SUCCESS || !accepted) {
+        std::cerr << "[Client] startSession rejected!" << std::endl;
         return 1;
     }
 
-    std::cout << "[Client] Receiving chunks..." << std::endl;
+    // A piece that cannot be stored aborts the stream
+    auto sink = [&](uint64_t offset, const uint8_t* data, size_t size) { return receiver.writeAt(offset, data, size); };
+
+    if (session.getDataEndpoint().compare(0, 6, "shm://") == 0) {
+        // Bulk bytes bypass SOME/IP; ignore sessionChunk broadcasts meant for other clients
+        subscriptions.dropChunks();
+
+        const std::string& endpoint = session.getDataEndpoint();
+        std::cout << "[Client] Receiving over shared memory ring " << endpoint << std::endl;
+
+        bool attached = false;
+        bool ok = ShmRingClient::receive(endpoint, sink, attached, idleTimeout.count());
+        if (attached) {
+            if (!ok || !receiver.finish()) return 1;
+
+            if (!toSlot) installedImage = "data/client/" + outputFilename;
+            return 0;
+        }
+
+        // Same kernel, but the ring is out of reach (another /dev/shm, another uid): ask for a socket path
+        std::cerr << "[Client] Shared memory ring unavailable, asking again without it" << std::endl;
+        request.setHostId("");
+        subscriptions.chunks = proxy->getSessionChunkEvent().subscribe(onChunk);
+        subscriptions.hasChunks = true;
 
-    while (true) std::this_thread::sleep_for(std::chrono::seconds(1));
+        proxy->startSession("qnx_uefi.iso", request, status, accepted, session, &callInfo);
+        if (status != CommonAPI::CallStatus::SUCCESS || !accepted) {
+            std::cerr << "[Client] startSession rejected!" << std::endl;
+            return 1;
+        }
+    }
+
+    // The chunk size is the server's transfer profile setting
+    const size_t chunkSize = session.getChunkSize() ? session.getChunkSize() : CHUNK_SIZE;
+    receiver.setChunkSize(chunkSize);
+
+    if (!session.getDataEndpoint().empty()) {
+        // Bulk bytes bypass SOME/IP; ignore sessionChunk broadcasts meant for other clients
+        subscriptions.dropChunks();
+
+        const std::string& endpoint = session.getDataEndpoint();
+        std::cout << "[Client] Receiving over data plane " << endpoint << " (" << static_cast<int>(std::max<uint8_t>(session.getStripes(), 1))
+                  << " stripe(s))" << std::endl;
+
+        bool ok = DataPlaneClient::receive(endpoint, session.getStripes(), chunkSize, sink, idleTimeout.count());
+        if (!ok || !receiver.finish()) return 1;
+
+        if (!toSlot) installedImage = "data/client/" + outputFilename;
+        return 0;
+    }
+
+    // Fulfilled by the writer thread once the last chunk is written and verified
+    auto completion = std::make_shared<std::promise<bool>>();
+    std::future<bool> completed = completion->get_future();
+    receiver.setCompletionHandler([completion](bool verified) { completion->set_value(verified); });
+
+    // [transfer] check_threads checksum chunks between the dispatch thread and the writer; 0 leaves it to the writer
+    receiver.setCheckThreads(static_cast<unsigned>(config.getUint("transfer", "check_threads", 2)));
+
+    std::cout << "[Client] Receiving " << (chunkSize / 1024) << " KB chunks for session " << session.getSessionId() << "..." << std::endl;
+    receiver.setSession(session.getSessionId());
+
+    uint64_t lastBytes = 0;
+    auto lastProgress = std::chrono::steady_clock::now();
+
+    // The watchdog period only bounds how late a stall is noticed; completion ends the wait at once
+    while (completed.wait_for(std::chrono::milliseconds(IDLE_CHECK_MS)) != std::future_status::ready) {
+        const uint64_t bytes = progress.snapshot().bytes;
+        const auto now = std::chrono::steady_clock::now();
+        if (bytes != lastBytes) {
+            lastBytes = bytes;
+            lastProgress = now;
+        } else if (idleTimeout.count() > 0 && now - lastProgress >= idleTimeout) {
+            std::cerr << std::endl << "[Client] No data for " << idleTimeout.count() << " ms, giving up" << std::endl;
+            progress.setPhase(ProgressReporter::Phase::Failed);
+            return 1;
+        }
+    }
+
+    const bool verified = completed.get();
+    {
+        std::lock_guard<std::mutex> lock(ackMutex);
+        if (lastAck.valid()) lastAck.wait_for(callTimeout);
+    }
+    if (!verified) return 1;
+
+    if (!toSlot) installedImage = "data/client/" + outputFilename;
+    return 0;
+}
+
+int main() {
+    IniConfig config;
+    config.load(IniConfig::defaultPath());
+
+    // Everything CommonAPI-related is torn down before a hand-off replaces the process
+    std::string installedImage;
+    int rc = runClient(config, installedImage);
+
+    // [transfer] apply_command (e.g. /usr/bin/ota-apply) installs a verified file-mode image right away
+    const std::string applyCommand = config.get("transfer", "apply_command", "");
+    if (rc == 0 && !installedImage.empty() && !applyCommand.empty()) {
+        handOff(applyCommand, installedImage);
+        return 1;
+    }
+    return rc;
 }
@@ -2,22 +2,46 @@
 #include <sys/types.h>
 
 #include <CommonAPI/CommonAPI.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cstdint>
+#include <cstdio>
+#include <ctime>
 #include <fstream>
 #include <iostream>
+#include <map>
+#include <mutex>
+#include <random>
 #include <sstream>
 #include <thread>
 #include <v0/filetransfer/example/FileTransferStubDefault.hpp>
 #include <vector>
 
+#include "ChunkCache.hpp"
+#include "DataPlane.hpp"
+#include "ImageReader.hpp"
+#include "ImageWarmer.hpp"
+#include "IniConfig.hpp"
+#include "Pacer.hpp"
+#include "SessionJournal.hpp"
+#include "ShmRing.hpp"
+#include "TransferProfile.hpp"
+#include "ota/Checksum.hpp"
+
 namespace ft = v0::filetransfer::example;
 
-static const std::string kUpdateDir = "data/server/";
-static const std::string kUpdateImage = kUpdateDir + "rootfs.ext4";
-static const std::string kUpdateVersion = kUpdateDir + "update.version";
-static const std::string kUpdateCrc = kUpdateDir + "update.crc";
+// File names inside the profile's update_dir
+static const std::string kVersionFile = "update.version";
+static const std::string kCrcFile = "update.crc";
+static const std::string kSha256File = "update.sha256";
+static const std::string kChecksumIdFile = "update.checksum-id";
+static const std::string kJournalFile = "sessions.journal";
 
-static const size_t CHUNK_SIZE = 64 * 1024;  // 64 KB
+// startTransfer (v0.1) streams: the chunk size those clients assume, and the
+// gap between chunks that was their only flow control, since they never ack
+static const uint32_t kLegacyChunkSize = 64 * 1024;
+static const unsigned kLegacyChunkGapMs = 10;
 
 // Simple file-exists helper (C++14 compatible)
 bool fileExists(const std::string& path) {
@@ -35,6 +59,25 @@ bool getFileSize(const std::string& path, uint64_t& sizeOut) {
     return false;
 }
 
+// Identify an image version without reading it: device, inode, size and mtime
+bool getImageId(const std::string& path, uint64_t& idOut) {
+    struct stat sb;
+    if (stat(path.c_str(), &sb) != 0 || !S_ISREG(sb.st_mode)) return false;
+
+    // FNV-1a over the identifying stat fields
+    const uint64_t fields[] = {static_cast<uint64_t>(sb.st_dev), static_cast<uint64_t>(sb.st_ino),
+                               static_cast<uint64_t>(sb.st_size), static_cast<uint64_t>(sb.st_mtime)};
+    uint64_t h = 1469598103934665603ULL;
+    for (uint64_t f : fields) {
+        for (int i = 0; i < 8; ++i) {
+            h ^= (f >> (i * 8)) & 0xFF;
+            h *= 1099511628211ULL;
+        }
+    }
+    idOut = h;
+    return true;
+}
+
 // Read uint32 from file helper
 bool readUint32FromFile(const std::string& path, uint32_t& valueOut) {
     std::ifstream in(path);
@@ -53,12 +96,434 @@ bool readUint32FromFile(const std::string& path, uint32_t& valueOut) {
     return !ss.fail();
 }
 
+// Image id the published checksums belong to, 0 if none was recorded
+uint64_t readChecksumImageId(const std::string& idPath) {
+    std::ifstream in(idPath);
+    uint64_t id = 0;
+    if (!(in >> std::hex >> id)) return 0;
+    return id;
+}
+
+bool olderThan(const std::string& path, const std::string& other) {
+    struct stat a, b;
+    return stat(path.c_str(), &a) == 0 && stat(other.c_str(), &b) == 0 && a.st_mtime < b.st_mtime;
+}
+
+// Writes update.crc / update.sha256 for the image when either is missing or
+// belongs to an image since replaced, so clients can always verify what they
+// received; one pass computes both. update.checksum-id records the image id
+// (getImageId) they were made for. Files provided by hand are kept unless
+// they predate the image. Returns the image id the files now describe, or 0.
+uint64_t publishChecksums(const std::string& image, const std::string& crcPath, const std::string& shaPath, const std::string& idPath) {
+    uint64_t imageId = 0;
+    if (!getImageId(image, imageId)) return 0;
+
+    const uint64_t publishedFor = readChecksumImageId(idPath);
+    if (publishedFor == imageId) return imageId;
+
+    if (fileExists(crcPath) && fileExists(shaPath)) {
+        if (publishedFor == 0 && !olderThan(crcPath, image) && !olderThan(shaPath, image)) {
+            std::ofstream out(idPath);
+            out << std::hex << imageId << std::endl;
+            return imageId;
+        }
+        std::cout << "[Service] " << image << " changed since its checksums were published, recomputing them" << std::endl;
+    }
+
+    std::ifstream in(image, std::ios::binary);
+    if (!in.is_open()) return 0;
+
+    Crc32 crc;
+    Sha256 sha;
+    std::vector<char> buf(4 * 1024 * 1024);
+    uint64_t total = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    while (in) {
+        in.read(buf.data(), static_cast<std::streamsize>(buf.size()));
+        std::streamsize n = in.gcount();
+        if (n <= 0) break;
+        crc.update(reinterpret_cast<const uint8_t*>(buf.data()), static_cast<size_t>(n));
+        sha.update(reinterpret_cast<const uint8_t*>(buf.data()), static_cast<size_t>(n));
+        total += static_cast<uint64_t>(n);
+    }
+    if (in.bad()) {
+        std::cerr << "[Service] Failed to read " << image << " for checksums" << std::endl;
+        return 0;
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    const std::string hex = sha.hexDigest();
+
+    // Replaced while it was being read: the next call hashes the new one
+    uint64_t after = 0;
+    if (!getImageId(image, after) || after != imageId) return 0;
+
+    std::ofstream crcOut(crcPath);
+    crcOut << "0x" << std::hex << crc.value() << std::endl;
+    std::ofstream shaOut(shaPath);
+    shaOut << hex << std::endl;
+    if (!crcOut || !shaOut) {
+        std::cerr << "[Service] Could not write the checksums of " << image << std::endl;
+        return 0;
+    }
+    std::ofstream idOut(idPath);
+    idOut << std::hex << imageId << std::endl;
+
+    std::cout << "[Service] Checksums of " << (total >> 20) << " MB in " << elapsed.count() << " s (crc32 " << crc.kernelName()
+              << ", sha256 " << sha.kernelName() << "): crc=0x" << std::hex << crc.value() << std::dec << " sha256=" << hex << std::endl;
+    return imageId;
+}
+
 class FileTransferService : public ft::FileTransferStubDefault {
    public:
-    FileTransferService() = default;
+    FileTransferService(const TransferProfile& profile, std::shared_ptr<DataPlaneServer> dataPlane, std::shared_ptr<ShmRingServer> shmRing,
+                        std::shared_ptr<ImageWarmer> warmer, std::shared_ptr<SessionJournal> journal)
+        : updateImage_(profile.imagePath()),
+          updateVersion_(profile.updateDir + kVersionFile),
+          updateCrc_(profile.updateDir + kCrcFile),
+          updateSha256_(profile.updateDir + kSha256File),
+          profile_(std::make_shared<const TransferProfile>(profile)),
+          cache_(profile.cacheBudget),
+          dataPlane_(std::move(dataPlane)),
+          shmRing_(std::move(shmRing)),
+          hostId_(localHostId()),
+          warmer_(std::move(warmer)),
+          journal_(std::move(journal)) {
+        std::random_device seed;
+        nextSessionId_ = journal_ ? journal_->lastSessionId() + 1 : (seed() & 0x7FFFFFFF) + 1;
+    }
+
+    // Image id the files in update_dir were published for, from publishChecksums()
+    void setChecksumImageId(uint64_t imageId) { checksumImageId_ = imageId; }
+
+    // Hot reload: new sessions pick up the profile, the cache budget and rate limit apply at once
+    void applyProfile(const TransferProfile& profile) {
+        std::shared_ptr<const TransferProfile> next = std::make_shared<const TransferProfile>(profile);
+        if (profile.imagePath() != updateImage_)
+            std::cerr << "[Service] Profile reload: image location changes need a restart, keeping " << updateImage_ << std::endl;
+
+        {
+            std::lock_guard<std::mutex> lock(profileMutex_);
+            profile_ = next;
+        }
+        cache_.setBudget(profile.cacheBudget);
+
+        std::cout << "[Service] Profile reloaded: " << profile.describe() << std::endl;
+    }
+
+    std::shared_ptr<const TransferProfile> profile() const {
+        std::lock_guard<std::mutex> lock(profileMutex_);
+        return profile_;
+    }
+
+    // Re-creates the journaled sessions of the current image. They stay parked
+    // until the client acks (or resumeParked() runs), since its subscription
+    // may not be back yet right after a restart. Sessions not acked for
+    // `maxAgeS` seconds are dropped: their client is not coming back.
+    void restoreSessions(const std::vector<SessionJournal::Entry>& entries, uint64_t maxAgeS) {
+        uint64_t imageId = 0;
+        getImageId(updateImage_, imageId);
+        std::shared_ptr<const TransferProfile> p = profile();
+        const int64_t now = static_cast<int64_t>(std::time(nullptr));
+
+        std::vector<uint32_t> closed;
+        std::unique_lock<std::mutex> lock(sessionsMutex_);
+        for (const SessionJournal::Entry& e : entries) {
+            if (e.imageId != imageId || e.acked >= e.chunkCount) {
+                closed.push_back(e.sessionId);
+                continue;
+            }
+            if (maxAgeS > 0 && e.updatedAt > 0 && now - e.updatedAt > static_cast<int64_t>(maxAgeS)) {
+                std::cout << "[Service] Dropping journaled session " << e.sessionId << " of client '" << e.clientId << "': last acked "
+                          << (now - e.updatedAt) << " s ago" << std::endl;
+                closed.push_back(e.sessionId);
+                continue;
+            }
+
+            auto s = std::make_shared<Session>(p->pacing);
+            s->id = e.sessionId;
+            s->clientId = e.clientId;
+            s->imageId = e.imageId;
+            s->chunkSize = e.chunkSize;
+            s->chunkCount = e.chunkCount;
+            s->acked = e.acked;
+            sessions_[s->id] = s;
+
+            std::cout << "[Service] Restored session " << s->id << " of client '" << s->clientId << "' at chunk " << s->acked << "/"
+                      << s->chunkCount << std::endl;
+        }
+        lock.unlock();
+
+        if (journal_) {
+            for (uint32_t id : closed) journal_->recordClose(id);
+        }
+    }
+
+    // Restarts restored sessions that no client has acked since the restart
+    void resumeParked() {
+        std::lock_guard<std::mutex> lock(sessionsMutex_);
+        for (auto& kv : sessions_) {
+            const std::shared_ptr<Session>& s = kv.second;
+            if (!s->running.exchange(true)) {
+                std::cout << "[Service] Resuming session " << s->id << " from chunk " << s->acked << std::endl;
+                std::thread(&FileTransferService::sendChunks, this, updateImage_, s, s->acked.load()).detach();
+            }
+        }
+    }
+
+    // Drops sessions whose client stopped acking, once no sender owns them:
+    // one that finished sending but never got its last acks, or a restored
+    // one whose client never returned. Otherwise they would stay in the
+    // journal and be streamed again after every restart.
+    void expireIdle() {
+        std::vector<std::shared_ptr<Session>> idle;
+        {
+            std::lock_guard<std::mutex> lock(sessionsMutex_);
+            for (const auto& kv : sessions_) {
+                if (!kv.second->running && expired(*kv.second)) idle.push_back(kv.second);
+            }
+        }
+
+        for (const std::shared_ptr<Session>& s : idle) {
+            // An ack arriving meanwhile may have started a resend, which then owns the session
+            if (!s->running.exchange(true)) expire(s);
+        }
+    }
 
     void requestUpdate(const std::shared_ptr<CommonAPI::ClientId> /*_client*/, uint32_t currentVersion,
                        requestUpdateReply_t reply) override {
+        std::string sha256;
+        reply(describeUpdate("requestUpdate", currentVersion, sha256));
+    }
+
+    void checkUpdate(const std::shared_ptr<CommonAPI::ClientId> /*_client*/, uint32_t currentVersion, checkUpdateReply_t reply) override {
+        std::string sha256;
+        ft::FileTransfer::UpdateInfo info = describeUpdate("checkUpdate", currentVersion, sha256);
+        reply(info, sha256);
+    }
+
+    // v0.1 clients: the whole image on fileChunk, outside the session machinery
+    void startTransfer(const std::shared_ptr<CommonAPI::ClientId> /*_client*/, std::string /*_fileName*/,
+                       startTransferReply_t reply) override {
+        if (!fileExists(updateImage_)) {
+            std::cerr << "[Service] startTransfer(): update image missing" << std::endl;
+            reply(false);
+            return;
+        }
+
+        std::thread(&FileTransferService::sendLegacy, this, updateImage_).detach();
+
+        std::cout << "[Service] startTransfer(): streaming " << updateImage_ << " to a v0.1 client" << std::endl;
+
+        reply(true);
+    }
+
+    void startSession(const std::shared_ptr<CommonAPI::ClientId> /*_client*/, std::string /*_fileName*/,
+                      ft::FileTransfer::TransferRequest request, startSessionReply_t reply) override {
+        ft::FileTransfer::TransferSession session;
+
+        if (!fileExists(updateImage_)) {
+            std::cerr << "[Service] startSession(): update image missing" << std::endl;
+            reply(false, session);
+            return;
+        }
+
+        reportResidency();
+        std::shared_ptr<const TransferProfile> p = profile();
+        session.setChunkSize(p->chunkSize);
+        // A client resuming a partial image already holds every chunk below its offset
+        const uint64_t resumeChunk = request.getResumeOffset() / p->chunkSize;
+
+        // Co-located client: hand out a shared-memory ring instead of any socket path
+        if (shmRing_ && !request.getHostId().empty() && request.getHostId() == hostId_) {
+            std::string endpoint = shmRing_->offer(updateImage_);
+            if (!endpoint.empty()) {
+                session.setDataEndpoint(endpoint);
+                std::cout << "[Service] startSession(): client is local, sharing " << updateImage_ << " via " << endpoint << std::endl;
+                reply(true, session);
+                return;
+            }
+        }
+
+        // Bulk bytes go over the TCP data plane when both sides opted in
+        if (request.getDataPlane() && dataPlane_) {
+            uint32_t stripes = std::max<uint32_t>(1, std::min<uint32_t>(request.getStripes(), p->maxStripes));
+            const uint64_t from = resumeChunk * p->chunkSize;
+            session.setDataEndpoint(dataPlane_->offer(updateImage_, stripes, p->chunkSize, from, request.getRangeEnd()));
+            session.setStripes(static_cast<uint8_t>(stripes));
+            std::cout << "[Service] startSession(): offering " << updateImage_ << " at " << session.getDataEndpoint() << " in " << stripes
+                      << " stripe(s)";
+            if (request.getRangeEnd() > 0) std::cout << ", bytes " << from << "-" << request.getRangeEnd();
+            else if (resumeChunk > 0) std::cout << ", resuming at chunk " << resumeChunk;
+            std::cout << std::endl;
+            reply(true, session);
+            return;
+        }
+
+        // A range (multi-source client) is only served by the data plane; a session would stream the whole image
+        if (request.getRangeEnd() > 0) {
+            std::cerr << "[Service] startSession(): range requested but the data plane is off, rejecting" << std::endl;
+            reply(false, session);
+            return;
+        }
+
+        // Never keep more in flight than the client said it can buffer ahead of its disk
+        Pacer::Config pacing = p->pacing;
+        if (request.getReceiveBuffer() > 0) {
+            uint32_t fit = std::max<uint32_t>(request.getReceiveBuffer() / p->chunkSize, 2);
+            pacing.maxWindow = std::min(pacing.maxWindow, fit);
+            pacing.minWindow = std::min(pacing.minWindow, pacing.maxWindow);
+            pacing.initialWindow = std::min(pacing.initialWindow, pacing.maxWindow);
+        }
+
+        uint64_t fileSize = 0;
+        auto s = std::make_shared<Session>(pacing);
+        s->clientId = request.getClientId();
+        s->chunkSize = p->chunkSize;
+        if (!getFileSize(updateImage_, fileSize) || !getImageId(updateImage_, s->imageId)) {
+            reply(false, session);
+            return;
+        }
+        s->chunkCount = static_cast<uint32_t>((fileSize + s->chunkSize - 1) / s->chunkSize);
+        s->acked = static_cast<uint32_t>(std::min<uint64_t>(resumeChunk, s->chunkCount));
+        s->running = true;
+
+        uint32_t active = 0;
+        std::vector<uint32_t> replaced;
+        {
+            std::lock_guard<std::mutex> lock(sessionsMutex_);
+
+            // Sessions this request is about to replace do not count against max_sessions
+            for (const auto& kv : sessions_) {
+                if (kv.second->running && (s->clientId.empty() || kv.second->clientId != s->clientId)) ++active;
+            }
+
+            if (active < p->maxSessions) {
+                // A client starting over abandons whatever it had in flight
+                for (auto it = sessions_.begin(); it != sessions_.end();) {
+                    if (!s->clientId.empty() && it->second->clientId == s->clientId) {
+                        it->second->cancelled = true;
+                        replaced.push_back(it->first);
+                        it = sessions_.erase(it);
+                    } else {
+                        ++it;
+                    }
+                }
+
+                s->id = nextSessionId_++;
+                sessions_[s->id] = s;
+            }
+        }
+
+        // Closes sync the journal, so they are written once other calls can take the lock again
+        if (journal_) {
+            for (uint32_t id : replaced) journal_->recordClose(id);
+        }
+
+        if (s->id == 0) {
+            std::cerr << "[Service] startSession(): " << active << " sessions already streaming, rejecting" << std::endl;
+            reply(false, session);
+            return;
+        }
+
+        if (journal_) {
+            SessionJournal::Entry e;
+            e.sessionId = s->id;
+            e.clientId = s->clientId;
+            e.imageId = s->imageId;
+            e.chunkSize = s->chunkSize;
+            e.chunkCount = s->chunkCount;
+            e.acked = s->acked;
+            journal_->recordOpen(e);
+        }
+
+        session.setSessionId(s->id);
+        std::thread(&FileTransferService::sendChunks, this, updateImage_, s, s->acked.load()).detach();
+
+        std::cout << "[Service] startSession(): streaming " << updateImage_ << " as session " << s->id << " in " << (s->chunkSize / 1024)
+                  << " KB chunks, window <= " << pacing.maxWindow;
+        if (s->acked > 0) std::cout << ", resuming at chunk " << s->acked << "/" << s->chunkCount;
+        std::cout << std::endl;
+
+        reply(true, session);
+    }
+
+    void ackChunks(const std::shared_ptr<CommonAPI::ClientId> /*_client*/, uint32_t sessionId, uint32_t nextChunk,
+                   ackChunksReply_t reply) override {
+        std::shared_ptr<Session> s;
+        {
+            std::lock_guard<std::mutex> lock(sessionsMutex_);
+            auto it = sessions_.find(sessionId);
+            if (it != sessions_.end()) s = it->second;
+        }
+
+        if (!s) {
+            reply(false);
+            return;
+        }
+
+        s->lastAckMs = steadyMs();
+        nextChunk = std::min(nextChunk, s->chunkCount);
+        s->pacer.onAck(nextChunk);
+        if (nextChunk > s->acked) {
+            s->acked = nextChunk;
+            if (journal_) journal_->recordAck(sessionId, nextChunk);
+        }
+
+        if (nextChunk >= s->chunkCount) {
+            s->cancelled = true;  // stops a resend that is still running
+            bool erased = false;
+            {
+                std::lock_guard<std::mutex> lock(sessionsMutex_);
+                erased = sessions_.erase(sessionId) > 0;
+            }
+            if (erased && journal_) journal_->recordClose(sessionId);
+            std::cout << "[Service] Session " << sessionId << " complete" << std::endl;
+        } else if (!s->running.exchange(true)) {
+            // Client is back (gateway restart) or saw a gap after the last chunk
+            std::cout << "[Service] Resuming session " << sessionId << " from chunk " << nextChunk << std::endl;
+            std::thread(&FileTransferService::sendChunks, this, updateImage_, s, nextChunk).detach();
+        }
+
+        reply(true);
+    }
+
+    void reportVerification(const std::shared_ptr<CommonAPI::ClientId> /*_client*/, uint32_t sessionId, bool verified, uint32_t crc,
+                            std::string sha256, reportVerificationReply_t reply) override {
+        bool known = false;
+        {
+            std::lock_guard<std::mutex> lock(sessionsMutex_);
+            known = sessions_.count(sessionId) > 0;
+        }
+
+        if (verified) {
+            std::cout << "[Service] Session " << sessionId << ": client verified the image" << std::endl;
+        } else {
+            std::cerr << "[Service] Session " << sessionId << ": client reports a corrupt image (CRC32 0x" << std::hex << crc << std::dec
+                      << ", SHA-256 " << sha256 << ")" << std::endl;
+        }
+
+        reply(known);
+    }
+
+    // Logs how much of the warmed image is still in the page cache
+    void reportResidency() const {
+        uint64_t imageId = 0;
+        if (!warmer_ || !getImageId(updateImage_, imageId) || imageId != warmer_->imageId()) return;
+
+        ImageWarmer::Residency r = warmer_->residency();
+        if (!r.measured) return;
+
+        char ratio[16];
+        std::snprintf(ratio, sizeof(ratio), "%.1f", r.ratio() * 100.0);
+        std::cout << "[Service] Image residency: " << (r.residentBytes / 1024) << " KB of " << (r.mappedBytes / 1024) << " KB (" << ratio
+                  << "%)" << (r.locked ? " locked" : "") << std::endl;
+    }
+
+   private:
+    // The reply of requestUpdate / checkUpdate; `sha256` is only sent by the latter
+    ft::FileTransfer::UpdateInfo describeUpdate(const char* method, uint32_t currentVersion, std::string& sha256) const {
         ft::FileTransfer::UpdateInfo info;
 
         uint64_t fileSize = 0;
@@ -74,104 +539,348 @@ class FileTransferService : public ft::FileTransferStubDefault {
         info.setResultCode(-1);
 
         // Check image existence
-        if (!fileExists(kUpdateImage)) {
+        if (!fileExists(updateImage_)) {
             info.setResultCode(-10);
-            reply(info);
-            return;
+            return info;
         }
 
         info.setExists(true);
 
         // File size
-        if (!getFileSize(kUpdateImage, fileSize)) {
+        if (!getFileSize(updateImage_, fileSize)) {
             info.setResultCode(-11);
-            reply(info);
-            return;
+            return info;
         }
         info.setSize(fileSize);
 
+        // Checksums still describe an image since replaced; every client would reject this one.
+        // Not offered until the main loop has published its own.
+        uint64_t imageId = 0;
+        if ((fileExists(updateCrc_) || fileExists(updateSha256_)) &&
+            (!getImageId(updateImage_, imageId) || imageId != checksumImageId_)) {
+            info.setResultCode(-13);
+            return info;
+        }
+
         // Version file
-        if (!readUint32FromFile(kUpdateVersion, newVersion)) {
+        if (!readUint32FromFile(updateVersion_, newVersion)) {
             info.setResultCode(-12);
-            reply(info);
-            return;
+            return info;
         }
         info.setNewVersion(newVersion);
 
         // Optional CRC
-        readUint32FromFile(kUpdateCrc, crc);
+        readUint32FromFile(updateCrc_, crc);
         info.setCrc(crc);
 
+        // Optional SHA-256, first field of the line so `sha256sum image > update.sha256` works
+        std::ifstream shaFile(updateSha256_);
+        if (!(shaFile >> sha256)) sha256.clear();
+
         // Version comparison
         info.setIsNew(newVersion > currentVersion);
         info.setResultCode(0);
 
-        std::cout << "[Service] requestUpdate(): clientVersion=" << currentVersion << " newVersion=" << newVersion << std::endl;
+        std::cout << "[Service] " << method << "(): clientVersion=" << currentVersion << " newVersion=" << newVersion << std::endl;
 
-        reply(info);
+        return info;
     }
 
-    void startTransfer(const std::shared_ptr<CommonAPI::ClientId> /*_client*/, std::string /*_fileName*/,
-                       startTransferReply_t reply) override {
-        if (!fileExists(kUpdateImage)) {
-            std::cerr << "[Service] startTransfer(): update image missing" << std::endl;
-            reply(false);
-            return;
-        }
+    static int64_t steadyMs() {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
 
-        std::thread(&FileTransferService::sendChunks, this, kUpdateImage).detach();
+    struct Session {
+        explicit Session(const Pacer::Config& pacing) : pacer(pacing), lastAckMs(steadyMs()) {}
+
+        uint32_t id = 0;
+        std::string clientId;
+        uint64_t imageId = 0;
+        uint32_t chunkSize = 0;
+        uint32_t chunkCount = 0;
+        std::atomic<uint32_t> acked{0};
+        std::atomic<bool> running{false};  // a sendChunks thread owns the session
+        std::atomic<bool> cancelled{false};
+        Pacer pacer;
+        std::atomic<int64_t> lastAckMs;  // steady clock; session start until the first ack
+    };
+
+    // No ack of any kind for session_expire_stalls stall periods
+    bool expired(const Session& s) const {
+        std::shared_ptr<const TransferProfile> p = profile();
+        const int64_t limitMs = static_cast<int64_t>(p->expireStalls) * p->pacing.stallMs;
+        return limitMs > 0 && steadyMs() - s.lastAckMs >= limitMs;
+    }
 
-        std::cout << "[Service] startTransfer(): streaming " << kUpdateImage << std::endl;
+    void expire(const std::shared_ptr<Session>& s) {
+        s->cancelled = true;
+        bool erased = false;
+        {
+            std::lock_guard<std::mutex> lock(sessionsMutex_);
+            auto it = sessions_.find(s->id);
+            if (it != sessions_.end() && it->second == s) {
+                sessions_.erase(it);
+                erased = true;
+            }
+        }
+        if (!erased) return;
 
-        reply(true);
+        if (journal_) journal_->recordClose(s->id);
+        std::cout << "[Service] Session " << s->id << " of client '" << s->clientId << "' expired at chunk " << s->acked << "/" << s->chunkCount
+                  << ": no ack for " << ((steadyMs() - s->lastAckMs) / 1000.0) << " s" << std::endl;
     }
 
-   private:
-    void sendChunks(const std::string& path) {
-        std::ifstream file(path.c_str(), std::ios::binary);
-        if (!file) {
+    void sendChunks(const std::string& path, std::shared_ptr<Session> session, uint32_t firstChunk) {
+        struct Done {
+            Session& s;
+            ~Done() { s.running = false; }
+        } done{*session};
+
+        uint64_t imageId = 0;
+        if (!getImageId(path, imageId) || imageId != session->imageId) {
+            std::cerr << "[Service] Image changed under session " << session->id << ", not sending" << std::endl;
+            return;
+        }
+
+        std::shared_ptr<const TransferProfile> p = profile();
+        std::unique_ptr<ImageReader> reader = ImageReader::open(path, session->chunkSize, p->ioQueueDepth, p->ioBackend);
+        if (!reader) {
             std::cerr << "[Service] Failed to open file: " << path << std::endl;
             return;
         }
 
-        uint32_t chunkIndex = 0;
-        std::vector<uint8_t> buffer(CHUNK_SIZE);
+        std::cout << "[Service] Reading " << path << " with " << reader->backendName() << " backend" << std::endl;
 
-        while (true) {
-            file.read(reinterpret_cast<char*>(buffer.data()), CHUNK_SIZE);
-            std::streamsize bytesRead = file.gcount();
-            if (bytesRead <= 0) break;
+        const uint32_t chunkCount = session->chunkCount;
+        Pacer& pacer = session->pacer;
+        pacer.reset(firstChunk, session->acked);
+        auto lastReport = std::chrono::steady_clock::now();
+        auto nextSendAt = lastReport;
 
-            bool lastChunk = (static_cast<size_t>(bytesRead) < CHUNK_SIZE);
-            CommonAPI::ByteBuffer data(buffer.begin(), buffer.begin() + bytesRead);
+        const uint64_t cacheId = cacheIdFor(imageId, session->chunkSize);
 
-            std::cout << "[Service] Sending chunk " << chunkIndex << " (" << bytesRead << " bytes)" << (lastChunk ? " [LAST]" : "")
-                      << std::endl;
+        // Chunks another session already read come from the cache, so read-ahead skips them
+        reader->setCacheProbe([this, cacheId](uint32_t index) { return cache_.contains(cacheId, index); });
+
+        for (uint32_t chunkIndex = firstChunk; chunkIndex < chunkCount && !session->cancelled; ++chunkIndex) {
+            // Hold back until the client's acks leave room in the window; a gap it reports is resent first
+            const uint32_t ahead = chunkIndex;
+            if (!pacer.waitForWindow(chunkIndex, session->cancelled) || chunkIndex >= chunkCount) break;
+            if (chunkIndex < ahead) std::cout << "[Service] Session " << session->id << ": resending from chunk " << chunkIndex << std::endl;
+
+            // Each stall lets one probe chunk through; a client that is gone must not get the rest that way
+            if (expired(*session)) {
+                expire(session);
+                return;
+            }
 
-            fireFileChunkEvent(chunkIndex, data, lastChunk);
-            ++chunkIndex;
+            ChunkCache::Chunk chunk = cache_.getOrLoad(
+                cacheId, chunkIndex, [&](std::vector<uint8_t>& buffer) { return reader->read(chunkIndex, buffer); });
 
-            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            if (!chunk) {
+                std::cerr << "[Service] Failed to read chunk " << chunkIndex << " of " << path << std::endl;
+                return;
+            }
+
+            bool lastChunk = (chunkIndex + 1 == chunkCount);
+
+            std::cout << "[Service] Sending chunk " << chunkIndex << " (" << chunk->size() << " bytes)" << (lastChunk ? " [LAST]" : "")
+                      << std::endl;
+
+            // rate_limit caps each session's bandwidth on top of the AIMD window
+            uint64_t rateLimit = profile()->rateLimit;
+            if (rateLimit > 0) {
+                std::this_thread::sleep_until(nextSendAt);
+                nextSendAt = std::max(nextSendAt, std::chrono::steady_clock::now()) +
+                             std::chrono::microseconds(chunk->size() * 1000000ULL / rateLimit);
+            }
+
+            auto fireStart = std::chrono::steady_clock::now();
+            fireSessionChunkEvent(session->id, chunkIndex, *chunk, lastChunk);
+            auto fireEnd = std::chrono::steady_clock::now();
+            pacer.onSent(chunkIndex, fireEnd - fireStart);
+
+            if (fireEnd - lastReport >= std::chrono::seconds(2)) {
+                reportPacing(*session);
+                lastReport = fireEnd;
+            }
         }
 
         std::cout << "[Service] Completed sending file: " << path << std::endl;
+        reportPacing(*session);
+        reportCacheStats();
+    }
+
+    // startTransfer streams: every chunk in order on fileChunk, not journaled and never resent
+    void sendLegacy(const std::string& path) {
+        uint64_t imageId = 0;
+        uint64_t fileSize = 0;
+        if (!getImageId(path, imageId) || !getFileSize(path, fileSize)) return;
+
+        std::shared_ptr<const TransferProfile> p = profile();
+        std::unique_ptr<ImageReader> reader = ImageReader::open(path, kLegacyChunkSize, p->ioQueueDepth, p->ioBackend);
+        if (!reader) {
+            std::cerr << "[Service] Failed to open file: " << path << std::endl;
+            return;
+        }
+
+        const uint64_t cacheId = cacheIdFor(imageId, kLegacyChunkSize);
+        reader->setCacheProbe([this, cacheId](uint32_t index) { return cache_.contains(cacheId, index); });
+
+        const uint32_t chunkCount = static_cast<uint32_t>((fileSize + kLegacyChunkSize - 1) / kLegacyChunkSize);
+        for (uint32_t chunkIndex = 0; chunkIndex < chunkCount; ++chunkIndex) {
+            ChunkCache::Chunk chunk = cache_.getOrLoad(
+                cacheId, chunkIndex, [&](std::vector<uint8_t>& buffer) { return reader->read(chunkIndex, buffer); });
+
+            if (!chunk) {
+                std::cerr << "[Service] Failed to read chunk " << chunkIndex << " of " << path << std::endl;
+                return;
+            }
+
+            bool lastChunk = (chunkIndex + 1 == chunkCount);
+            fireFileChunkEvent(chunkIndex, *chunk, lastChunk);
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(kLegacyChunkGapMs));
+        }
+
+        std::cout << "[Service] Completed sending file: " << path << " (" << chunkCount << " chunks on fileChunk)" << std::endl;
+    }
+
+    // Chunks of different sizes must not share cache entries
+    static uint64_t cacheIdFor(uint64_t imageId, uint32_t chunkSize) {
+        return imageId ^ (static_cast<uint64_t>(chunkSize) * 0x9E3779B97F4A7C15ULL);
+    }
+
+    void reportPacing(const Session& session) const {
+        Pacer::Stats p = session.pacer.stats();
+        char rtt[48];
+        std::snprintf(rtt, sizeof(rtt), "srtt=%.1fms minRtt=%.1fms", p.srttMs, p.minRttMs);
+        std::cout << "[Service] Pacing session " << session.id << ": window=" << static_cast<uint32_t>(p.window) << " inFlight=" << p.inFlight
+                  << " (" << (static_cast<uint64_t>(p.inFlight) * session.chunkSize / 1024) << " KB) " << rtt << " increases=" << p.increases
+                  << " decreases=" << p.decreases << " slowSends=" << p.slowSends << " stalls=" << p.stalls << " rewinds=" << p.rewinds << std::endl;
     }
+
+    void reportCacheStats() const {
+        ChunkCache::Stats s = cache_.stats();
+        char ratio[16];
+        std::snprintf(ratio, sizeof(ratio), "%.1f", s.hitRatio() * 100.0);
+        std::cout << "[Service] Chunk cache: hits=" << s.hits << " misses=" << s.misses << " evictions=" << s.evictions
+                  << " hitRatio=" << ratio << "% cached=" << (s.bytesCached / 1024) << " KB in " << s.entries << " chunks" << std::endl;
+    }
+
+    const std::string updateImage_;
+    const std::string updateVersion_;
+    const std::string updateCrc_;
+    const std::string updateSha256_;
+    std::atomic<uint64_t> checksumImageId_{0};  // image the published checksums describe
+
+    mutable std::mutex profileMutex_;
+    std::shared_ptr<const TransferProfile> profile_;
+
+    ChunkCache cache_;
+    std::shared_ptr<DataPlaneServer> dataPlane_;
+    std::shared_ptr<ShmRingServer> shmRing_;
+    std::string hostId_;
+    std::shared_ptr<ImageWarmer> warmer_;
+
+    std::shared_ptr<SessionJournal> journal_;
+    std::mutex sessionsMutex_;
+    std::map<uint32_t, std::shared_ptr<Session>> sessions_;
+    uint32_t nextSessionId_ = 1;
 };
 
 int main() {
     CommonAPI::Runtime::setProperty("LibraryBase", "FileTransfer");
     auto runtime = CommonAPI::Runtime::get();
 
-    auto service = std::make_shared<FileTransferService>();
+    // The [transfer] section is the transfer profile; see README "Transfer Configuration"
+    const std::string configPath = IniConfig::defaultPath();
+    IniConfig config;
+    config.load(configPath);
+    TransferProfile profile = TransferProfile::fromConfig(config);
+    std::cout << "[Service] Transfer profile: " << profile.describe() << std::endl;
+
+    // [transfer] dataplane=tcp enables the out-of-band bulk data plane
+    std::shared_ptr<DataPlaneServer> dataPlane;
+    if (config.get("transfer", "dataplane", "events") == "tcp") {
+        dataPlane = std::make_shared<DataPlaneServer>(config.get("transfer", "dataplane_address", "127.0.0.1"),
+                                                      static_cast<uint16_t>(config.getUint("transfer", "dataplane_port", 30510)));
+        if (!dataPlane->start()) dataPlane.reset();
+    }
+
+    // [transfer] shm=auto uses a shared-memory ring for clients on this host
+    std::shared_ptr<ShmRingServer> shmRing;
+    if (config.get("transfer", "shm", "auto") != "off") {
+        shmRing = std::make_shared<ShmRingServer>(static_cast<uint32_t>(config.getUint("transfer", "shm_slots", 64)),
+                                                  static_cast<uint32_t>(config.getUint("transfer", "shm_slot_size", profile.chunkSize)));
+    }
+
+    // [transfer] warmup=fault|lock makes the image resident before the service is offered
+    std::shared_ptr<ImageWarmer> warmer;
+    ImageWarmer::Mode warmupMode = ImageWarmer::parseMode(config.get("transfer", "warmup", "off"));
+    uint64_t imageId = 0;
+    if (warmupMode != ImageWarmer::Mode::Off && getImageId(profile.imagePath(), imageId)) {
+        warmer = std::make_shared<ImageWarmer>(warmupMode, config.getUint("transfer", "warmup_bytes", 0));
+        if (!warmer->warm(profile.imagePath(), imageId)) warmer.reset();
+    }
+
+    // Runs after warmup so the pass is served from the page cache when warmup is on
+    const std::string crcPath = profile.updateDir + kCrcFile;
+    const std::string shaPath = profile.updateDir + kSha256File;
+    const std::string checksumIdPath = profile.updateDir + kChecksumIdFile;
+    uint64_t checksumImageId = publishChecksums(profile.imagePath(), crcPath, shaPath, checksumIdPath);
+    getImageId(profile.imagePath(), imageId);
+    uint64_t checkedImageId = imageId;
+
+    // [transfer] journal= keeps event-path sessions across gateway restarts; empty disables it
+    std::shared_ptr<SessionJournal> journal;
+    std::vector<SessionJournal::Entry> restored;
+    std::string journalPath = config.get("transfer", "journal", profile.updateDir + kJournalFile);
+    if (!journalPath.empty()) {
+        journal = std::make_shared<SessionJournal>(journalPath, static_cast<unsigned>(config.getUint("transfer", "journal_sync_ms", 200)));
+        if (!journal->open(restored)) journal.reset();
+    }
+
+    auto service = std::make_shared<FileTransferService>(profile, dataPlane, shmRing, warmer, journal);
+    service->setChecksumImageId(checksumImageId);
+    // [transfer] journal_max_age_s: journaled sessions not acked for longer are not restored, 0 keeps them all
+    service->restoreSessions(restored, config.getUint("transfer", "journal_max_age_s", 86400));
 
-    bool ok = runtime->registerService("local", "filetransfer.example.FileTransfer", service, "service-sample");
+    // [transfer] instance: a second gateway serving the same image registers as e.g. filetransfer.example.FileTransferPeer
+    const std::string instance = config.get("transfer", "instance", "filetransfer.example.FileTransfer");
+    bool ok = runtime->registerService("local", instance, service, "service-sample");
 
     if (!ok) {
         std::cerr << "[Service] Failed to register service." << std::endl;
         return 1;
     }
 
-    std::cout << "[Service] File Transfer Service running..." << std::endl;
+    std::cout << "[Service] File Transfer Service running as " << instance << "..." << std::endl;
+    service->reportResidency();
+
+    // Clients normally re-ack as soon as they see the service again; this covers those that do not
+    if (!restored.empty()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(config.getUint("transfer", "resume_grace_ms", 2000)));
+        service->resumeParked();
+    }
+
+    // [transfer] reload_ms: how often the profile file is checked for edits, 0 disables hot reload
+    const uint64_t reloadMs = config.getUint("transfer", "reload_ms", 2000);
+    ProfileWatcher watcher(configPath);
 
-    while (true) std::this_thread::sleep_for(std::chrono::seconds(1));
+    while (true) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(reloadMs ? reloadMs : 1000));
+
+        if (reloadMs && watcher.changed()) {
+            IniConfig fresh;
+            if (fresh.load(configPath)) service->applyProfile(TransferProfile::fromConfig(fresh));
+        }
+        service->expireIdle();
+
+        // An image replaced in place (new update.version) gets checksums of its own; one attempt per image
+        if (getImageId(profile.imagePath(), imageId) && imageId != checkedImageId) {
+            checkedImageId = imageId;
+            service->setChecksumImageId(publishChecksums(profile.imagePath(), crcPath, shaPath, checksumIdPath));
+        }
+    }
 }
@@ -0,0 +1,337 @@
+#include "ImageReader.hpp"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+#if defined(HAVE_IO_URING)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#endif
+
+namespace {
+
+bool preadFull(int fd, uint8_t* buf, size_t size, uint64_t offset, size_t& got) {
+    got = 0;
+    while (got < size) {
+        ssize_t n = pread(fd, buf + got, size - got, static_cast<off_t>(offset + got));
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0) return false;
+        if (n == 0) break;  // end of file
+        got += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+class PreadImageReader : public ImageReader {
+   public:
+    PreadImageReader(int fd, uint64_t size, size_t chunkSize) : fd_(fd), size_(size), chunkSize_(chunkSize) {}
+    ~PreadImageReader() override { close(fd_); }
+
+    bool read(uint32_t index, std::vector<uint8_t>& out) override {
+        uint64_t offset = static_cast<uint64_t>(index) * chunkSize_;
+        if (offset >= size_) return false;
+
+        out.resize(chunkSize_);
+        size_t got = 0;
+        if (!preadFull(fd_, out.data(), out.size(), offset, got) || got == 0) return false;
+        out.resize(got);
+        return true;
+    }
+
+    const char* backendName() const override { return "pread"; }
+
+   private:
+    int fd_;
+    uint64_t size_;
+    size_t chunkSize_;
+};
+
+#if defined(HAVE_IO_URING)
+
+int uringSetup(unsigned entries, io_uring_params* p) { return static_cast<int>(syscall(__NR_io_uring_setup, entries, p)); }
+
+int uringEnter(int fd, unsigned toSubmit, unsigned minComplete, unsigned flags) {
+    return static_cast<int>(syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, nullptr, 0));
+}
+
+int uringRegister(int fd, unsigned opcode, const void* arg, unsigned nrArgs) {
+    return static_cast<int>(syscall(__NR_io_uring_register, fd, opcode, arg, nrArgs));
+}
+
+// Raw io_uring (no liburing dependency) with one registered buffer per
+// queue slot. Reads ahead sequentially: after chunk N is consumed, those of
+// chunks N+1 .. N+depth that are not cached are kept in flight.
+class UringImageReader : public ImageReader {
+   public:
+    UringImageReader(int fd, uint64_t size, size_t chunkSize, unsigned depth)
+        : fd_(fd), size_(size), chunkSize_(chunkSize), depth_(depth ? depth : 1) {}
+
+    ~UringImageReader() override {
+        if (ringFd_ >= 0) {
+            // Let in-flight reads land before their buffers go away
+            for (Slot& s : slots_) {
+                if (s.index >= 0 && !s.done) waitFor(s);
+            }
+            close(ringFd_);
+        }
+        if (sqPtr_ != MAP_FAILED) munmap(sqPtr_, sqMapSize_);
+        if (cqPtr_ != MAP_FAILED && cqPtr_ != sqPtr_) munmap(cqPtr_, cqMapSize_);
+        if (sqes_ != MAP_FAILED) munmap(sqes_, sqesMapSize_);
+        close(fd_);
+    }
+
+    bool init() {
+        io_uring_params p;
+        std::memset(&p, 0, sizeof(p));
+        ringFd_ = uringSetup(depth_, &p);
+        if (ringFd_ < 0) return false;
+
+        sqMapSize_ = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+        cqMapSize_ = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+        const bool single = (p.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single) sqMapSize_ = cqMapSize_ = std::max(sqMapSize_, cqMapSize_);
+
+        sqPtr_ = mmap(nullptr, sqMapSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd_, IORING_OFF_SQ_RING);
+        if (sqPtr_ == MAP_FAILED) return false;
+        cqPtr_ = single ? sqPtr_
+                        : mmap(nullptr, cqMapSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd_, IORING_OFF_CQ_RING);
+        if (cqPtr_ == MAP_FAILED) return false;
+
+        sqesMapSize_ = p.sq_entries * sizeof(io_uring_sqe);
+        sqes_ = mmap(nullptr, sqesMapSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd_, IORING_OFF_SQES);
+        if (sqes_ == MAP_FAILED) return false;
+
+        uint8_t* sq = static_cast<uint8_t*>(sqPtr_);
+        sqTail_ = reinterpret_cast<unsigned*>(sq + p.sq_off.tail);
+        sqMask_ = *reinterpret_cast<unsigned*>(sq + p.sq_off.ring_mask);
+        sqArray_ = reinterpret_cast<unsigned*>(sq + p.sq_off.array);
+
+        uint8_t* cq = static_cast<uint8_t*>(cqPtr_);
+        cqHead_ = reinterpret_cast<unsigned*>(cq + p.cq_off.head);
+        cqTail_ = reinterpret_cast<unsigned*>(cq + p.cq_off.tail);
+        cqMask_ = *reinterpret_cast<unsigned*>(cq + p.cq_off.ring_mask);
+        cqes_ = reinterpret_cast<io_uring_cqe*>(cq + p.cq_off.cqes);
+
+        // One registered buffer per slot: READ_FIXED skips per-I/O page pinning
+        slots_.resize(depth_);
+        std::vector<iovec> iov(depth_);
+        for (unsigned i = 0; i < depth_; ++i) {
+            slots_[i].buffer.resize(chunkSize_);
+            iov[i].iov_base = slots_[i].buffer.data();
+            iov[i].iov_len = chunkSize_;
+        }
+        return uringRegister(ringFd_, IORING_REGISTER_BUFFERS, iov.data(), depth_) == 0;
+    }
+
+    bool read(uint32_t index, std::vector<uint8_t>& out) override {
+        const uint64_t offset = static_cast<uint64_t>(index) * chunkSize_;
+        if (offset >= size_) return false;
+
+        reclaimBehind(index);
+        Slot* slot = find(index);
+        if (!slot) {
+            slot = acquire();
+            if (!slot || !submit(*slot, index)) return false;
+        }
+
+        if (!slot->done && !waitFor(*slot)) return false;
+
+        const size_t expected = static_cast<size_t>(std::min<uint64_t>(chunkSize_, size_ - offset));
+        bool ok = slot->result >= 0;
+        size_t got = ok ? static_cast<size_t>(slot->result) : 0;
+
+        out.assign(slot->buffer.begin(), slot->buffer.begin() + got);
+        slot->index = -1;
+
+        // Short read: finish the chunk synchronously
+        if (ok && got < expected) {
+            size_t more = 0;
+            out.resize(expected);
+            ok = preadFull(fd_, out.data() + got, expected - got, offset + got, more);
+            out.resize(got + more);
+        }
+
+        readAhead(index + 1);
+        return ok && !out.empty();
+    }
+
+    const char* backendName() const override { return "io_uring"; }
+
+    void setCacheProbe(CacheProbe cached) override { cached_ = std::move(cached); }
+
+   private:
+    struct Slot {
+        std::vector<uint8_t> buffer;
+        int64_t index = -1;  // chunk in this slot, -1 if free
+        bool done = false;
+        int result = 0;
+    };
+
+    Slot* find(uint32_t index) {
+        for (Slot& s : slots_) {
+            if (s.index == static_cast<int64_t>(index)) return &s;
+        }
+        return nullptr;
+    }
+
+    // Reads only move forward, so prefetches below `index` were skipped,
+    // their chunks served from the cache; all of them are freed at once
+    void reclaimBehind(uint32_t index) {
+        for (Slot& s : slots_) {
+            if (s.index < 0 || s.index >= static_cast<int64_t>(index)) continue;
+            if (!s.done && !waitFor(s)) return;
+            s.index = -1;
+        }
+    }
+
+    // Free slot, or the oldest prefetch if a seek made the read-ahead useless
+    Slot* acquire() {
+        for (Slot& s : slots_) {
+            if (s.index < 0) return &s;
+        }
+        Slot* victim = &slots_[0];
+        for (Slot& s : slots_) {
+            if (s.index < victim->index) victim = &s;
+        }
+        if (!victim->done && !waitFor(*victim)) return nullptr;
+        victim->index = -1;
+        return victim;
+    }
+
+    void readAhead(uint32_t next) {
+        for (unsigned i = 0; i < depth_; ++i) {
+            uint64_t index = static_cast<uint64_t>(next) + i;
+            if (index * chunkSize_ >= size_) break;
+            if (find(static_cast<uint32_t>(index))) continue;
+            if (cached_ && cached_(static_cast<uint32_t>(index))) continue;
+
+            Slot* free = nullptr;
+            for (Slot& s : slots_) {
+                if (s.index < 0) {
+                    free = &s;
+                    break;
+                }
+            }
+            if (!free || !submit(*free, static_cast<uint32_t>(index))) break;
+        }
+    }
+
+    bool submit(Slot& slot, uint32_t index) {
+        const unsigned tail = *sqTail_;
+        const unsigned pos = tail & sqMask_;
+        const unsigned bufIndex = static_cast<unsigned>(&slot - slots_.data());
+
+        io_uring_sqe* sqe = static_cast<io_uring_sqe*>(sqes_) + pos;
+        std::memset(sqe, 0, sizeof(*sqe));
+        sqe->opcode = IORING_OP_READ_FIXED;
+        sqe->fd = fd_;
+        sqe->off = static_cast<uint64_t>(index) * chunkSize_;
+        sqe->addr = reinterpret_cast<uint64_t>(slot.buffer.data());
+        sqe->len = static_cast<uint32_t>(chunkSize_);
+        sqe->buf_index = static_cast<uint16_t>(bufIndex);
+        sqe->user_data = bufIndex;
+
+        sqArray_[pos] = pos;
+        __atomic_store_n(sqTail_, tail + 1, __ATOMIC_RELEASE);
+
+        slot.index = index;
+        slot.done = false;
+
+        int rc;
+        do {
+            rc = uringEnter(ringFd_, 1, 0, 0);
+        } while (rc < 0 && errno == EINTR);
+        return rc >= 0;
+    }
+
+    bool waitFor(Slot& slot) {
+        while (!slot.done) {
+            unsigned head = *cqHead_;
+            unsigned tail = __atomic_load_n(cqTail_, __ATOMIC_ACQUIRE);
+
+            if (head == tail) {
+                int rc = uringEnter(ringFd_, 0, 1, IORING_ENTER_GETEVENTS);
+                if (rc < 0 && errno != EINTR) return false;
+                continue;
+            }
+
+            for (; head != tail; ++head) {
+                const io_uring_cqe& cqe = cqes_[head & cqMask_];
+                if (cqe.user_data < slots_.size()) {
+                    Slot& s = slots_[cqe.user_data];
+                    s.result = cqe.res;
+                    s.done = true;
+                }
+            }
+            __atomic_store_n(cqHead_, head, __ATOMIC_RELEASE);
+        }
+        return true;
+    }
+
+    int fd_;
+    uint64_t size_;
+    size_t chunkSize_;
+    unsigned depth_;
+
+    int ringFd_ = -1;
+    void* sqPtr_ = MAP_FAILED;
+    void* cqPtr_ = MAP_FAILED;
+    void* sqes_ = MAP_FAILED;
+    size_t sqMapSize_ = 0;
+    size_t cqMapSize_ = 0;
+    size_t sqesMapSize_ = 0;
+
+    unsigned* sqTail_ = nullptr;
+    unsigned sqMask_ = 0;
+    unsigned* sqArray_ = nullptr;
+    unsigned* cqHead_ = nullptr;
+    unsigned* cqTail_ = nullptr;
+    unsigned cqMask_ = 0;
+    io_uring_cqe* cqes_ = nullptr;
+
+    std::vector<Slot> slots_;
+    CacheProbe cached_;
+};
+
+#endif  // HAVE_IO_URING
+
+}  // namespace
+
+std::unique_ptr<ImageReader> ImageReader::open(const std::string& path, size_t chunkSize, unsigned queueDepth,
+                                               const std::string& backend) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return nullptr;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return nullptr;
+    }
+    const uint64_t size = static_cast<uint64_t>(st.st_size);
+
+#if defined(HAVE_IO_URING)
+    if (backend != "pread") {
+        std::unique_ptr<UringImageReader> uring(new UringImageReader(fd, size, chunkSize, queueDepth));
+        if (uring->init()) return std::unique_ptr<ImageReader>(uring.release());
+
+        // init() failure leaves fd owned by the reader; reopen for the fallback
+        uring.reset();
+        std::cerr << "[Service] io_uring unavailable (" << std::strerror(errno) << "), falling back to pread" << std::endl;
+        fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return nullptr;
+    }
+#else
+    (void)queueDepth;
+    if (backend == "uring") std::cerr << "[Service] io_uring not built in, using pread" << std::endl;
+#endif
+
+    return std::unique_ptr<ImageReader>(new PreadImageReader(fd, size, chunkSize));
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Reads an update image in fixed-size chunks for the sendChunks pipeline.
+// The io_uring backend (Linux, HAVE_IO_URING) keeps up to `queueDepth`
+// sequential reads in flight into registered buffers, so storage latency
+// overlaps with sending. The pread backend is the portable fallback.
+class ImageReader {
+   public:
+    virtual ~ImageReader() {}
+
+    // Reads chunk `index` into `out` (resized to the bytes read). Returns
+    // false on I/O error or when the chunk lies past the end of the image.
+    virtual bool read(uint32_t index, std::vector<uint8_t>& out) = 0;
+
+    virtual const char* backendName() const = 0;
+
+    // Asked before a chunk is read ahead; true means it is in the ChunkCache
+    // already and read() will not be called for it
+    typedef std::function<bool(uint32_t index)> CacheProbe;
+    virtual void setCacheProbe(CacheProbe cached) { (void)cached; }
+
+    // backend: "auto" (io_uring if usable, else pread), "uring" or "pread".
+    // Returns nullptr if the image cannot be opened.
+    static std::unique_ptr<ImageReader> open(const std::string& path, size_t chunkSize, unsigned queueDepth,
+                                             const std::string& backend);
+};
@@ -0,0 +1,115 @@
+#include "ImageWarmer.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+ImageWarmer::ImageWarmer(Mode mode, uint64_t limitBytes) : mode_(mode), limitBytes_(limitBytes) {}
+
+ImageWarmer::~ImageWarmer() { release(); }
+
+ImageWarmer::Mode ImageWarmer::parseMode(const std::string& value) {
+    if (value == "fault") return Mode::Fault;
+    if (value == "lock") return Mode::Lock;
+    return Mode::Off;
+}
+
+void ImageWarmer::release() {
+    if (!base_) return;
+    if (locked_) munlock(base_, length_);
+    munmap(base_, length_);
+    base_ = nullptr;
+    length_ = 0;
+    locked_ = false;
+}
+
+bool ImageWarmer::warm(const std::string& path, uint64_t imageId) {
+    release();
+    if (mode_ == Mode::Off) return true;
+
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "[Service] Warm-up: cannot open " << path << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        close(fd);
+        return false;
+    }
+
+    uint64_t length = static_cast<uint64_t>(st.st_size);
+    if (limitBytes_ > 0) length = std::min(length, limitBytes_);
+
+    auto start = std::chrono::steady_clock::now();
+
+    void* base = mmap(nullptr, static_cast<size_t>(length), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);  // the mapping keeps the file referenced
+    if (base == MAP_FAILED) {
+        std::cerr << "[Service] Warm-up: mmap failed: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    base_ = base;
+    length_ = static_cast<size_t>(length);
+    imageId_ = imageId;
+
+    // Start readahead for the whole range before faulting page by page
+    posix_madvise(base_, length_, POSIX_MADV_WILLNEED);
+
+    if (mode_ == Mode::Lock) {
+        if (mlock(base_, length_) == 0) {
+            locked_ = true;
+        } else {
+            // Typically RLIMIT_MEMLOCK; the pages still get faulted in below
+            std::cerr << "[Service] Warm-up: mlock failed (" << std::strerror(errno) << "), pre-faulting only" << std::endl;
+        }
+    }
+
+    if (!locked_) {
+        const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        const volatile uint8_t* p = static_cast<const volatile uint8_t*>(base_);
+        uint8_t sink = 0;
+        for (size_t off = 0; off < length_; off += page) sink ^= p[off];
+        (void)sink;
+    }
+
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "[Service] Warm-up: " << (length_ / 1024) << " KB of " << path << (locked_ ? " locked" : " pre-faulted")
+              << " in " << secs << " s" << std::endl;
+    return true;
+}
+
+ImageWarmer::Residency ImageWarmer::residency() const {
+    Residency r;
+    r.mappedBytes = length_;
+    r.locked = locked_;
+    if (!base_) return r;
+
+#if defined(__linux__)
+    const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    std::vector<unsigned char> vec((length_ + page - 1) / page);
+    if (mincore(base_, length_, vec.data()) == 0) {
+        uint64_t pages = 0;
+        for (unsigned char v : vec) pages += (v & 1);
+        r.residentBytes = std::min<uint64_t>(pages * page, length_);
+        r.measured = true;
+    }
+#else
+    // No mincore() here (QNX); locked pages are resident by definition
+    if (locked_) {
+        r.residentBytes = length_;
+        r.measured = true;
+    }
+#endif
+    return r;
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Pulls the published image (or its first `limitBytes`) into memory before
+// the service is offered, so the first client of a rollout does not pay
+// cold-storage latency. "fault" touches every page once; "lock" also mlock()s
+// the range so it cannot be reclaimed while the gateway runs.
+class ImageWarmer {
+   public:
+    enum class Mode { Off, Fault, Lock };
+
+    struct Residency {
+        uint64_t mappedBytes = 0;    // bytes of the image covered by the warm-up
+        uint64_t residentBytes = 0;  // of those, currently in the page cache
+        bool locked = false;
+        bool measured = false;  // false where mincore() is unavailable
+
+        double ratio() const {
+            return mappedBytes ? static_cast<double>(residentBytes) / static_cast<double>(mappedBytes) : 0.0;
+        }
+    };
+
+    ImageWarmer(Mode mode, uint64_t limitBytes);
+    ~ImageWarmer();
+
+    ImageWarmer(const ImageWarmer&) = delete;
+    ImageWarmer& operator=(const ImageWarmer&) = delete;
+
+    // Maps and pre-faults (or locks) the image; blocks until it is resident
+    bool warm(const std::string& path, uint64_t imageId);
+
+    // Page-cache residency of the warmed range, sampled now
+    Residency residency() const;
+
+    // Image id the warm-up applies to, 0 before warm()
+    uint64_t imageId() const { return imageId_; }
+
+    // "off", "fault" or "lock"; anything else is Off
+    static Mode parseMode(const std::string& value);
+
+   private:
+    void release();
+
+    Mode mode_;
+    uint64_t limitBytes_;
+    uint64_t imageId_ = 0;
+
+    void* base_ = nullptr;
+    size_t length_ = 0;
+    bool locked_ = false;
+};
@@ -0,0 +1,324 @@
+#include "ImageWriter.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace {
+
+// O_DIRECT offset/length/address alignment; covers 512 B and 4 KB sector devices
+const size_t kAlign = 4096;
+
+// Coalescing buffers open at once. Pieces normally complete an extent
+// before the next one opens (a few more with data plane stripes); when
+// out-of-order data would need more, the least recently used buffer is
+// written out as is.
+const size_t kMaxExtents = 8;
+
+bool pwriteFull(int fd, const uint8_t* data, size_t size, uint64_t offset) {
+    size_t done = 0;
+    while (done < size) {
+        ssize_t n = pwrite(fd, data + done, size - done, static_cast<off_t>(offset + done));
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        done += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+// Reads up to `size` bytes; `got` stops short at end of file
+bool preadFull(int fd, uint8_t* data, size_t size, uint64_t offset, size_t& got) {
+    got = 0;
+    while (got < size) {
+        ssize_t n = pread(fd, data + got, size - got, static_cast<off_t>(offset + got));
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0) return false;
+        if (n == 0) break;
+        got += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+class PwriteImageWriter : public ImageWriter {
+   public:
+    explicit PwriteImageWriter(int fd) : fd_(fd) {}
+    ~PwriteImageWriter() override { close(fd_); }
+
+    bool write(uint64_t offset, const uint8_t* data, size_t size) override { return pwriteFull(fd_, data, size, offset); }
+
+    bool read(uint64_t offset, uint8_t* data, size_t size) override {
+        size_t got = 0;
+        return preadFull(fd_, data, size, offset, got) && got == size;
+    }
+
+    bool flush() override { return fdatasync(fd_) == 0; }
+
+    const char* backendName() const override { return "pwrite"; }
+
+   private:
+    int fd_;
+};
+
+struct FreeDeleter {
+    void operator()(uint8_t* p) const { std::free(p); }
+};
+typedef std::unique_ptr<uint8_t, FreeDeleter> AlignedBuffer;
+
+class CoalescingImageWriter : public ImageWriter {
+   public:
+    // `fd` is a regular descriptor; `directFd` an O_DIRECT one on the same file, or -1
+    CoalescingImageWriter(int fd, int directFd, uint64_t imageSize, size_t extentSize)
+        : fd_(fd), directFd_(directFd), imageSize_(imageSize), extentSize_(extentSize) {}
+
+    ~CoalescingImageWriter() override {
+        if (directFd_ >= 0) close(directFd_);
+        close(fd_);
+    }
+
+    bool write(uint64_t offset, const uint8_t* data, size_t size) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        while (size > 0) {
+            // Past the announced size there is no extent to coalesce into
+            if (offset >= imageSize_) return pwriteFull(fd_, data, size, offset);
+
+            const uint64_t base = offset - offset % extentSize_;
+            const size_t len = static_cast<size_t>(std::min<uint64_t>(extentSize_, imageSize_ - base));
+            const size_t at = static_cast<size_t>(offset - base);
+            const size_t n = std::min(size, len - at);
+
+            Extent* e = extentFor(base, len);
+            if (!e) return false;
+            std::memcpy(e->buffer.get() + at, data, n);
+            e->add(at, n);
+            e->lastUse = ++useCounter_;
+
+            // An extent that fails to go out stays buffered with the pieces accepted
+            // into it; this piece fails instead, and its resend retries the write
+            if (e->complete()) {
+                if (!writeExtent(base, *e)) return false;
+                release(base);
+            }
+
+            offset += n;
+            data += n;
+            size -= n;
+        }
+        return true;
+    }
+
+    bool read(uint64_t offset, uint8_t* data, size_t size) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        // Disk first (zeros past its end), then whatever is still buffered on top
+        size_t got = 0;
+        if (!preadFull(fd_, data, size, offset, got)) return false;
+        std::memset(data + got, 0, size - got);
+
+        bool covered = (got == size);
+        const uint64_t end = offset + size;
+        for (const auto& kv : extents_) {
+            const uint64_t base = kv.first;
+            const Extent& e = kv.second;
+            if (base >= end || base + e.len <= offset) continue;
+
+            for (const auto& r : e.filled) {
+                const uint64_t from = std::max<uint64_t>(offset, base + r.first);
+                const uint64_t to = std::min<uint64_t>(end, base + r.second);
+                if (from < to) std::memcpy(data + (from - offset), e.buffer.get() + (from - base), static_cast<size_t>(to - from));
+            }
+            covered = true;  // a short read is expected while the tail is still buffered
+        }
+        return covered;
+    }
+
+    bool flush() override {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        bool ok = true;
+        while (!extents_.empty()) {
+            ok = writePartial(extents_.begin()->first, extents_.begin()->second) && ok;
+            release(extents_.begin()->first);
+        }
+        finishWriteback();
+        return fdatasync(fd_) == 0 && ok;
+    }
+
+    const char* backendName() const override { return directFd_ >= 0 ? "direct" : "writeback"; }
+
+   private:
+    struct Extent {
+        AlignedBuffer buffer;
+        size_t len = 0;
+        std::map<size_t, size_t> filled;  // start -> end, merged
+        size_t filledBytes = 0;
+        uint64_t lastUse = 0;
+
+        void add(size_t start, size_t n) {
+            size_t end = start + n;
+            auto it = filled.upper_bound(start);
+            if (it != filled.begin() && std::prev(it)->second >= start) --it;
+            while (it != filled.end() && it->first <= end) {
+                start = std::min(start, it->first);
+                end = std::max(end, it->second);
+                filledBytes -= it->second - it->first;
+                it = filled.erase(it);
+            }
+            filled[start] = end;
+            filledBytes += end - start;
+        }
+
+        bool complete() const { return filledBytes == len; }
+    };
+
+    // The extent at `base`, opened if needed. Null if a buffer had to be
+    // evicted and could not be written: it is kept, so the pieces earlier
+    // writes accepted are not lost, and the piece asking for room fails.
+    Extent* extentFor(uint64_t base, size_t len) {
+        auto it = extents_.find(base);
+        if (it != extents_.end()) return &it->second;
+
+        if (extents_.size() >= kMaxExtents) {
+            auto victim = std::min_element(extents_.begin(), extents_.end(), [](const std::pair<const uint64_t, Extent>& a,
+                                                                                const std::pair<const uint64_t, Extent>& b) {
+                return a.second.lastUse < b.second.lastUse;
+            });
+            if (!writePartial(victim->first, victim->second)) {
+                std::cerr << std::endl << "[Client] Write failed at offset " << victim->first << ", keeping it buffered" << std::endl;
+                return nullptr;
+            }
+            release(victim->first);
+        }
+
+        Extent& e = extents_[base];
+        e.len = len;
+        if (!pool_.empty()) {
+            e.buffer = std::move(pool_.back());
+            pool_.pop_back();
+        } else {
+            void* p = nullptr;
+            if (posix_memalign(&p, kAlign, extentSize_) != 0) throw std::bad_alloc();
+            e.buffer.reset(static_cast<uint8_t*>(p));
+        }
+        return &e;
+    }
+
+    void release(uint64_t base) {
+        auto it = extents_.find(base);
+        pool_.push_back(std::move(it->second.buffer));
+        extents_.erase(it);
+    }
+
+    // A complete extent: the aligned body goes out in one large write
+    bool writeExtent(uint64_t base, const Extent& e) {
+        const size_t body = e.len - e.len % kAlign;
+
+        if (directFd_ >= 0 && body > 0) {
+            if (pwriteFull(directFd_, e.buffer.get(), body, base)) {
+                // The unaligned tail of the image cannot go through O_DIRECT
+                return pwriteFull(fd_, e.buffer.get() + body, e.len - body, base + body);
+            }
+            if (errno != EINVAL) return false;
+
+            // Filesystem accepted the open but not the I/O
+            std::cerr << std::endl << "[Client] O_DIRECT write rejected, switching to writeback" << std::endl;
+            close(directFd_);
+            directFd_ = -1;
+        }
+
+        if (!pwriteFull(fd_, e.buffer.get(), e.len, base)) return false;
+        startWriteback(base, e.len);
+        return true;
+    }
+
+    // An extent with holes (evicted or flushed early): write only the filled ranges
+    bool writePartial(uint64_t base, const Extent& e) {
+        if (e.complete()) return writeExtent(base, e);
+
+        for (const auto& r : e.filled) {
+            if (!pwriteFull(fd_, e.buffer.get() + r.first, r.second - r.first, base + r.first)) return false;
+        }
+        return true;
+    }
+
+    // Writeback mode: start writing this extent now, then wait for the
+    // previous one and drop its pages, so dirty and cached image data stay
+    // around one extent instead of growing with the file
+    void startWriteback(uint64_t base, size_t len) {
+#if defined(__linux__)
+        sync_file_range(fd_, static_cast<off_t>(base), static_cast<off_t>(len), SYNC_FILE_RANGE_WRITE);
+#endif
+        finishWriteback();
+        pendingBase_ = base;
+        pendingLen_ = len;
+    }
+
+    void finishWriteback() {
+        if (pendingLen_ == 0) return;
+#if defined(__linux__)
+        sync_file_range(fd_, static_cast<off_t>(pendingBase_), static_cast<off_t>(pendingLen_),
+                        SYNC_FILE_RANGE_WAIT_BEFORE | SYNC_FILE_RANGE_WRITE | SYNC_FILE_RANGE_WAIT_AFTER);
+#endif
+        posix_fadvise(fd_, static_cast<off_t>(pendingBase_), static_cast<off_t>(pendingLen_), POSIX_FADV_DONTNEED);
+        pendingLen_ = 0;
+    }
+
+    int fd_;
+    int directFd_;
+    uint64_t imageSize_;
+    size_t extentSize_;
+
+    std::mutex mutex_;
+    std::map<uint64_t, Extent> extents_;  // by aligned base offset
+    std::vector<AlignedBuffer> pool_;
+    uint64_t useCounter_ = 0;
+    uint64_t pendingBase_ = 0;
+    size_t pendingLen_ = 0;
+};
+
+// Reserves the whole image up front so the filesystem can lay it out contiguously
+void preallocate(int fd, uint64_t size) {
+#if defined(__linux__)
+    if (fallocate(fd, 0, 0, static_cast<off_t>(size)) == 0) return;
+    std::cerr << "[Client] fallocate failed (" << std::strerror(errno) << "), output is allocated as written" << std::endl;
+#endif
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0)
+        std::cerr << "[Client] ftruncate failed (" << std::strerror(errno) << ")" << std::endl;
+}
+
+}  // namespace
+
+std::unique_ptr<ImageWriter> ImageWriter::open(const std::string& path, bool inPlace, uint64_t imageSize, const std::string& backend,
+                                               size_t bufferSize) {
+    int fd = ::open(path.c_str(), inPlace ? (O_RDWR | O_CLOEXEC) : (O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC), 0644);
+    if (fd < 0) return nullptr;
+
+    // Without a known size there is nothing to preallocate or align extents to
+    if (backend == "pwrite" || imageSize == 0) return std::unique_ptr<ImageWriter>(new PwriteImageWriter(fd));
+
+    if (!inPlace) preallocate(fd, imageSize);
+
+    bufferSize = std::max(kAlign, (bufferSize + kAlign - 1) / kAlign * kAlign);
+
+    int directFd = -1;
+#if defined(O_DIRECT)
+    if (backend != "writeback") {
+        directFd = ::open(path.c_str(), O_WRONLY | O_DIRECT | O_CLOEXEC);
+        if (directFd < 0) std::cerr << "[Client] O_DIRECT unavailable (" << std::strerror(errno) << "), using writeback" << std::endl;
+    }
+#else
+    if (backend == "direct") std::cerr << "[Client] O_DIRECT not supported here, using writeback" << std::endl;
+#endif
+
+    return std::unique_ptr<ImageWriter>(new CoalescingImageWriter(fd, directFd, imageSize, bufferSize));
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+// Output side of the client: places received pieces at their image offset.
+//
+// The pwrite backend writes every piece through the page cache as it
+// arrives. The direct and writeback backends preallocate the whole image
+// with fallocate and coalesce pieces into aligned `bufferSize` extents, so
+// the SD card sees large sequential writes and the file is laid out in few
+// extents. A full extent goes out with O_DIRECT (direct), or through the
+// page cache with sync_file_range starting writeback at once and the pages
+// dropped once written (writeback); either way a 1-4 GB board does not end
+// up with the image twice in RAM.
+class ImageWriter {
+   public:
+    virtual ~ImageWriter() {}
+
+    // Stores `size` bytes at `offset`. Safe to call from several threads.
+    // False means this piece must be written again. Pieces accepted earlier
+    // stay buffered until they reach the disk, so a failure never takes
+    // back an earlier success; flush() reports any that never got there.
+    virtual bool write(uint64_t offset, const uint8_t* data, size_t size) = 0;
+
+    // Reads back bytes that were written, including those still held in a
+    // coalescing buffer. Fails on I/O error or short read.
+    virtual bool read(uint64_t offset, uint8_t* data, size_t size) = 0;
+
+    // Writes out everything still buffered and makes the image durable
+    virtual bool flush() = 0;
+
+    virtual const char* backendName() const = 0;
+
+    // backend: "auto" (direct, else writeback, else pwrite), "direct",
+    // "writeback" or "pwrite". `inPlace` writes into an existing file or
+    // partition without truncating it. Returns nullptr if the output
+    // cannot be opened.
+    static std::unique_ptr<ImageWriter> open(const std::string& path, bool inPlace, uint64_t imageSize, const std::string& backend,
+                                             size_t bufferSize);
+};
@@ -0,0 +1,63 @@
+#include "IniConfig.hpp"
+
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+namespace {
+
+std::string trim(const std::string& s) {
+    const char* ws = " \t\r\n";
+    size_t b = s.find_first_not_of(ws);
+    if (b == std::string::npos) return "";
+    size_t e = s.find_last_not_of(ws);
+    return s.substr(b, e - b + 1);
+}
+
+}  // namespace
+
+bool IniConfig::load(const std::string& path) {
+    std::ifstream in(path);
+    if (!in.is_open()) return false;
+
+    std::string section;
+    std::string line;
+    while (std::getline(in, line)) {
+        line = trim(line);
+        if (line.empty() || line[0] == '#' || line[0] == ';') continue;
+
+        if (line.front() == '[' && line.back() == ']') {
+            section = trim(line.substr(1, line.size() - 2));
+            continue;
+        }
+
+        size_t eq = line.find('=');
+        if (eq == std::string::npos) continue;
+        values_[section + "." + trim(line.substr(0, eq))] = trim(line.substr(eq + 1));
+    }
+    return true;
+}
+
+std::string IniConfig::get(const std::string& section, const std::string& key, const std::string& fallback) const {
+    auto it = values_.find(section + "." + key);
+    return (it != values_.end()) ? it->second : fallback;
+}
+
+uint64_t IniConfig::getUint(const std::string& section, const std::string& key, uint64_t fallback) const {
+    auto it = values_.find(section + "." + key);
+    if (it == values_.end()) return fallback;
+
+    std::stringstream ss(it->second);
+    uint64_t value = 0;
+    if (it->second.find("0x") == 0 || it->second.find("0X") == 0)
+        ss >> std::hex >> value;
+    else
+        ss >> std::dec >> value;
+
+    return ss.fail() ? fallback : value;
+}
+
+std::string IniConfig::defaultPath() {
+    const char* env = std::getenv("COMMONAPI_CONFIG");
+    return (env && *env) ? env : "commonapi4someip.ini";
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+// Minimal reader for the application's own sections in the CommonAPI ini
+// file (e.g. [transfer]). CommonAPI ignores sections it does not know.
+class IniConfig {
+   public:
+    bool load(const std::string& path);
+
+    std::string get(const std::string& section, const std::string& key, const std::string& fallback) const;
+    uint64_t getUint(const std::string& section, const std::string& key, uint64_t fallback) const;
+
+    // Same file CommonAPI loads: $COMMONAPI_CONFIG, else commonapi4someip.ini
+    static std::string defaultPath();
+
+   private:
+    std::map<std::string, std::string> values_;  // "section.key" -> value
+};
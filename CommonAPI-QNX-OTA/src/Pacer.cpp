@@ -0,0 +1,136 @@
+#include "Pacer.hpp"
+
+#include <algorithm>
+
+Pacer::Pacer(const Config& config)
+    : config_(config),
+      window_(std::max(config.minWindow, std::min(config.initialWindow, config.maxWindow))),
+      ssthresh_(config.maxWindow) {}
+
+void Pacer::reset(uint32_t next, uint32_t acked) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    next_ = next;
+    acked_ = std::min(acked, next);
+    recoverUntil_ = 0;
+    dupAcks_ = 0;
+    rewind_ = false;
+    probing_ = false;
+    sendTimes_.clear();
+}
+
+bool Pacer::waitForWindow(uint32_t& index, const std::atomic<bool>& cancelled) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    uint32_t lastAcked = acked_;
+
+    while (!cancelled) {
+        // Duplicate acks: the client misses acked_ while holding chunks above it
+        if (rewind_) {
+            rewind_ = false;
+            probing_ = false;
+            index = acked_;
+            ++counters_.rewinds;
+            decrease(false);
+            return true;
+        }
+
+        index = std::max(index, acked_);
+        if (!probing_ && index < acked_ + static_cast<uint32_t>(window_)) return true;
+
+        bool progressed = cv_.wait_for(lock, std::chrono::milliseconds(config_.stallMs),
+                                       [&] { return cancelled || rewind_ || acked_ != lastAcked; });
+        if (progressed) {
+            lastAcked = acked_;
+            continue;
+        }
+
+        // Nothing acked for a whole stall period: back off, then probe with the chunk the client is missing
+        ++counters_.stalls;
+        decrease(true);
+        index = acked_;
+        probing_ = true;
+        return !cancelled;
+    }
+    return false;
+}
+
+void Pacer::onSent(uint32_t index, std::chrono::steady_clock::duration sendTime) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // Resent chunks give no RTT sample: the ack may be for the first copy
+    if (index >= next_) sendTimes_.emplace_back(index, std::chrono::steady_clock::now());
+    next_ = std::max(next_, index + 1);
+
+    if (sendTime > std::chrono::milliseconds(config_.slowSendMs)) {
+        ++counters_.slowSends;
+        decrease(false);
+    }
+}
+
+void Pacer::onAck(uint32_t nextChunk) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (nextChunk < acked_) return;
+
+    if (nextChunk == acked_) {
+        // Repeated while chunks past it are out: the client reports a gap at acked_
+        if (next_ > acked_ && ++dupAcks_ >= kDupAcks) {
+            dupAcks_ = 0;
+            rewind_ = true;
+            cv_.notify_all();
+        }
+        return;
+    }
+
+    const uint32_t newlyAcked = nextChunk - acked_;
+    acked_ = nextChunk;
+    dupAcks_ = 0;
+    probing_ = false;
+
+    // RTT of the newest chunk covered by this ack
+    auto now = std::chrono::steady_clock::now();
+    bool sampled = false;
+    double rttMs = 0;
+    while (!sendTimes_.empty() && sendTimes_.front().first < nextChunk) {
+        if (sendTimes_.front().first + 1 == nextChunk) {
+            rttMs = std::chrono::duration<double, std::milli>(now - sendTimes_.front().second).count();
+            sampled = true;
+        }
+        sendTimes_.pop_front();
+    }
+
+    if (sampled) {
+        srttMs_ = (srttMs_ == 0) ? rttMs : 0.875 * srttMs_ + 0.125 * rttMs;
+        minRttMs_ = (minRttMs_ == 0) ? rttMs : std::min(minRttMs_, rttMs);
+    }
+
+    // Queueing delay: smoothed RTT far above the best seen on this path
+    if (sampled && srttMs_ > 2.0 * minRttMs_ + 5.0) {
+        decrease(false);
+    } else if (window_ < config_.maxWindow) {
+        // Slow start below ssthresh, then roughly +1 chunk per window of acks
+        window_ += (window_ < ssthresh_) ? newlyAcked : static_cast<double>(newlyAcked) / window_;
+        window_ = std::min<double>(window_, config_.maxWindow);
+        ++counters_.increases;
+    }
+
+    cv_.notify_all();
+}
+
+void Pacer::decrease(bool force) {
+    // One reaction per window of data, except for stalls which back off every time
+    if (!force && acked_ < recoverUntil_) return;
+
+    window_ = std::max<double>(config_.minWindow, window_ / 2);
+    ssthresh_ = window_;
+    recoverUntil_ = next_;
+    ++counters_.decreases;
+}
+
+Pacer::Stats Pacer::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats s = counters_;
+    s.window = window_;
+    s.inFlight = next_ > acked_ ? next_ - acked_ : 0;
+    s.srttMs = srttMs_;
+    s.minRttMs = minRttMs_;
+    return s;
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <utility>
+
+// AIMD send window for one event-path session, replacing the fixed sleep
+// between sessionChunk events. The window counts chunks sent but not yet
+// acknowledged by ackChunks. It grows additively while acks keep up and is
+// halved, at most once per window, when the sender sees backpressure:
+// fireSessionChunkEvent blocking on a full send queue, ack RTT rising well
+// above its minimum, or no ack progress for stallMs.
+// Loss is repaired by going back to the first unacknowledged chunk: after
+// kDupAcks acks repeating the watermark, and for the probe sent on a stall.
+class Pacer {
+   public:
+    struct Config {
+        uint32_t initialWindow = 32;
+        uint32_t minWindow = 16;  // keep >= 2x the client ack_interval
+        uint32_t maxWindow = 256;
+        unsigned stallMs = 1000;    // no ack progress for this long counts as congestion
+        unsigned slowSendMs = 20;   // a single fire call taking longer means the queue is full
+    };
+
+    static const uint32_t kDupAcks = 2;
+
+    struct Stats {
+        double window = 0;
+        uint32_t inFlight = 0;  // chunks sent and not yet acked
+        uint64_t increases = 0;
+        uint64_t decreases = 0;
+        uint64_t stalls = 0;
+        uint64_t slowSends = 0;
+        uint64_t rewinds = 0;  // resends from the watermark on duplicate acks
+        double srttMs = 0;
+        double minRttMs = 0;
+    };
+
+    explicit Pacer(const Config& config);
+
+    // Starts a (re)send at chunk `next` with an acked watermark of `acked`
+    void reset(uint32_t next, uint32_t acked);
+
+    // Blocks until chunk `index` fits in the window and sets `index` to the
+    // chunk to send: moved up past chunks acked meanwhile, or back to the
+    // watermark when the client reports a gap or has gone quiet. A stall
+    // probe is sent alone; the window reopens on the next ack. Returns
+    // false once `cancelled` is set.
+    bool waitForWindow(uint32_t& index, const std::atomic<bool>& cancelled);
+
+    // Records that `index` went out and how long the fire call blocked
+    void onSent(uint32_t index, std::chrono::steady_clock::duration sendTime);
+
+    // Client watermark: chunks [0, nextChunk) arrived
+    void onAck(uint32_t nextChunk);
+
+    Stats stats() const;
+
+   private:
+    void decrease(bool force);
+
+    Config config_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+
+    double window_;
+    double ssthresh_;
+    uint32_t acked_ = 0;
+    uint32_t next_ = 0;
+    uint32_t recoverUntil_ = 0;  // no further decrease until acks pass this chunk
+    uint32_t dupAcks_ = 0;       // acks in a row repeating acked_
+    bool rewind_ = false;        // resend from acked_ next
+    bool probing_ = false;       // a stall probe is out, nothing else until an ack
+
+    std::deque<std::pair<uint32_t, std::chrono::steady_clock::time_point>> sendTimes_;
+    double srttMs_ = 0;
+    double minRttMs_ = 0;
+
+    Stats counters_;
+};
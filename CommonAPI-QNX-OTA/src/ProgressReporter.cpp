@@ -0,0 +1,241 @@
+#include "ProgressReporter.hpp"
+
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+#if !defined(MSG_NOSIGNAL)
+#define MSG_NOSIGNAL 0
+#endif
+
+namespace {
+
+// Time constant of the throughput EWMA: long enough to ride out a slow
+// SD card flush or a resend, short enough to follow a real rate change
+const double kRateTauSeconds = 3.0;
+
+const auto kConsoleInterval = std::chrono::seconds(1);
+
+int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+std::string formatEta(double seconds) {
+    if (seconds < 0) return "--:--";
+    long s = std::lround(seconds);
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%ld:%02ld", s / 60, s % 60);
+    return buf;
+}
+
+}  // namespace
+
+ProgressReporter::ProgressReporter(const Config& config) : config_(config) {}
+
+ProgressReporter::~ProgressReporter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_one();
+    if (thread_.joinable()) thread_.join();
+
+    for (int fd : clients_) close(fd);
+    if (listenFd_ >= 0) {
+        close(listenFd_);
+        unlink(config_.socketPath.c_str());
+    }
+}
+
+void ProgressReporter::start() {
+    lastSample_ = std::chrono::steady_clock::now();
+
+    if (!config_.socketPath.empty()) {
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        if (config_.socketPath.size() >= sizeof(addr.sun_path)) {
+            std::cerr << "[Client] Progress socket path too long: " << config_.socketPath << std::endl;
+        } else {
+            std::strcpy(addr.sun_path, config_.socketPath.c_str());
+
+            // A stale socket from a previous run would make bind() fail
+            unlink(config_.socketPath.c_str());
+
+            listenFd_ = socket(AF_UNIX, SOCK_STREAM, 0);
+            if (listenFd_ < 0 || fcntl(listenFd_, F_SETFL, O_NONBLOCK) != 0 ||
+                bind(listenFd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || listen(listenFd_, 4) != 0) {
+                std::cerr << "[Client] Progress socket " << config_.socketPath << " unavailable (" << std::strerror(errno) << ")" << std::endl;
+                if (listenFd_ >= 0) close(listenFd_);
+                listenFd_ = -1;
+            }
+        }
+    }
+
+    thread_ = std::thread(&ProgressReporter::run, this);
+}
+
+void ProgressReporter::setPhase(Phase phase) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (phase_ == phase) return;
+        phase_ = phase;
+        phaseChanged_ = true;
+    }
+    wake_.notify_one();
+}
+
+void ProgressReporter::add(uint64_t bytes) {
+    bytes_.fetch_add(bytes, std::memory_order_relaxed);
+
+    if (firstByteNs_.load(std::memory_order_relaxed) == 0) {
+        int64_t expected = 0;
+        if (firstByteNs_.compare_exchange_strong(expected, nowNs())) setPhase(Phase::Downloading);
+    }
+}
+
+void ProgressReporter::addResumed(uint64_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    bytes_.fetch_add(bytes, std::memory_order_relaxed);
+    lastBytes_ += bytes;
+}
+
+ProgressReporter::Snapshot ProgressReporter::snapshot() const {
+    Snapshot s;
+    s.phase = phase_;
+    s.bytes = bytes_.load(std::memory_order_relaxed);
+    s.total = total_;
+
+    const int64_t first = firstByteNs_.load();
+    if (first != 0) s.elapsedSeconds = static_cast<double>(nowNs() - first) / 1e9;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    s.rate = rate_;
+    if (s.total != 0 && s.bytes >= s.total) s.etaSeconds = 0;
+    else if (s.total != 0 && rate_ > 0) s.etaSeconds = static_cast<double>(s.total - s.bytes) / rate_;
+    return s;
+}
+
+const char* ProgressReporter::phaseName(Phase phase) {
+    switch (phase) {
+        case Phase::Waiting: return "waiting";
+        case Phase::Downloading: return "downloading";
+        case Phase::Verifying: return "verifying";
+        case Phase::Done: return "done";
+        case Phase::Failed: return "failed";
+    }
+    return "unknown";
+}
+
+void ProgressReporter::run() {
+    const auto tick = std::chrono::milliseconds(1000 / std::max<uint32_t>(std::min<uint32_t>(config_.hz, 1000), 1));
+    auto nextConsole = std::chrono::steady_clock::now();
+    uint64_t publishedBytes = 0;
+    uint64_t printedBytes = 0;
+    bool stopping = false;
+
+    // Exits after one last round, so the final phase reaches connected GUIs
+    while (!stopping) {
+        bool changed = false;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait_for(lock, tick, [&] { return stop_ || phaseChanged_; });
+            changed = phaseChanged_;
+            phaseChanged_ = false;
+            stopping = stop_;
+        }
+
+        sample();
+        Snapshot s = snapshot();
+
+        const auto now = std::chrono::steady_clock::now();
+        if (s.phase == Phase::Downloading && s.bytes != printedBytes && now >= nextConsole) {
+            printConsole(s);
+            nextConsole = now + kConsoleInterval;
+            printedBytes = s.bytes;
+        }
+
+        if (listenFd_ < 0) continue;
+
+        const std::string line = toJson(s);
+        if (changed || stopping || s.bytes != publishedBytes) {
+            sendToClients(line);
+            publishedBytes = s.bytes;
+        }
+        acceptClients(line);
+    }
+}
+
+void ProgressReporter::sample() {
+    const auto now = std::chrono::steady_clock::now();
+    const uint64_t bytes = bytes_.load(std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    const double dt = std::chrono::duration<double>(now - lastSample_).count();
+    if (dt <= 0) return;
+
+    if (phase_ == Phase::Downloading) {
+        const double instant = static_cast<double>(bytes - lastBytes_) / dt;
+        if (!haveRate_) {
+            if (bytes > lastBytes_) {
+                rate_ = instant;
+                haveRate_ = true;
+            }
+        } else {
+            rate_ += (1.0 - std::exp(-dt / kRateTauSeconds)) * (instant - rate_);
+        }
+    }
+
+    lastBytes_ = bytes;
+    lastSample_ = now;
+}
+
+void ProgressReporter::printConsole(const Snapshot& s) {
+    std::cout << "\r[Client] Downloading ";
+    if (s.total) std::cout << static_cast<int>(s.percent()) << "% ";
+    else std::cout << (s.bytes >> 20) << " MB ";
+    std::cout << "(" << static_cast<int>(s.rate / (1024 * 1024)) << " MB/s, ETA " << formatEta(s.etaSeconds) << ")   " << std::flush;
+}
+
+std::string ProgressReporter::toJson(const Snapshot& s) {
+    char line[256];
+    std::snprintf(line, sizeof(line),
+                  "{\"phase\":\"%s\",\"bytes\":%llu,\"total\":%llu,\"percent\":%.1f,\"rate\":%.0f,\"eta\":%.1f,\"elapsed\":%.1f}\n",
+                  phaseName(s.phase), static_cast<unsigned long long>(s.bytes), static_cast<unsigned long long>(s.total), s.percent(), s.rate,
+                  s.etaSeconds, s.elapsedSeconds);
+    return line;
+}
+
+void ProgressReporter::acceptClients(const std::string& line) {
+    while (true) {
+        int fd = accept(listenFd_, nullptr, nullptr);
+        if (fd < 0) return;
+
+        // A new GUI gets the current state straight away instead of at the next change
+        if (send(fd, line.data(), line.size(), MSG_NOSIGNAL | MSG_DONTWAIT) != static_cast<ssize_t>(line.size())) {
+            close(fd);
+            continue;
+        }
+        clients_.push_back(fd);
+    }
+}
+
+void ProgressReporter::sendToClients(const std::string& line) {
+    // A GUI that cannot take a whole line right now is dropped rather than
+    // left with a torn message; it reconnects and gets a fresh snapshot
+    for (auto it = clients_.begin(); it != clients_.end();) {
+        if (send(*it, line.data(), line.size(), MSG_NOSIGNAL | MSG_DONTWAIT) != static_cast<ssize_t>(line.size())) {
+            close(*it);
+            it = clients_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Download progress of the client, decoupled from the write path. Writers
+// only add the bytes they committed (one atomic add); a publisher thread
+// samples that counter at a fixed rate, smooths the throughput with an
+// EWMA, derives the ETA, and publishes:
+//
+//  - to the Qt GUI over a local stream socket (QLocalSocket connects to
+//    the path directly), one JSON object per line, at most `hz` times a
+//    second and only when something changed, plus at once on every phase
+//    change and to each newly connected GUI;
+//  - to stdout, once a second while downloading.
+class ProgressReporter {
+   public:
+    enum class Phase { Waiting, Downloading, Verifying, Done, Failed };
+
+    struct Config {
+        std::string socketPath;  // empty: no GUI channel
+        uint32_t hz = 10;
+    };
+
+    struct Snapshot {
+        Phase phase = Phase::Waiting;
+        uint64_t bytes = 0;       // committed to the output
+        uint64_t total = 0;       // image size, 0 if unknown
+        double rate = 0;          // smoothed, bytes/s
+        double etaSeconds = -1;   // -1 while unknown
+        double elapsedSeconds = 0;  // since the first byte
+
+        double percent() const { return total ? 100.0 * static_cast<double>(bytes) / static_cast<double>(total) : 0.0; }
+    };
+
+    explicit ProgressReporter(const Config& config);
+    ~ProgressReporter();
+
+    ProgressReporter(const ProgressReporter&) = delete;
+    ProgressReporter& operator=(const ProgressReporter&) = delete;
+
+    // Opens the GUI socket (if configured) and starts publishing
+    void start();
+
+    void setTotal(uint64_t total) { total_ = total; }
+
+    // Published right away, not at the next tick
+    void setPhase(Phase phase);
+
+    // Bytes just committed to the output. Safe from any thread.
+    void add(uint64_t bytes);
+
+    // Bytes already on disk from an interrupted run; they count towards the
+    // progress but not the throughput. Call before the download starts.
+    void addResumed(uint64_t bytes);
+
+    Snapshot snapshot() const;
+
+    static const char* phaseName(Phase phase);
+
+   private:
+    void run();
+    void sample();
+    void printConsole(const Snapshot& s);
+    static std::string toJson(const Snapshot& s);
+    void acceptClients(const std::string& line);
+    void sendToClients(const std::string& line);
+
+    Config config_;
+
+    std::atomic<uint64_t> bytes_{0};
+    std::atomic<uint64_t> total_{0};
+    std::atomic<int64_t> firstByteNs_{0};  // steady_clock, 0 until the first byte
+    std::atomic<Phase> phase_{Phase::Waiting};
+
+    mutable std::mutex mutex_;  // guards the smoothed values below and wakes run()
+    std::condition_variable wake_;
+    bool phaseChanged_ = false;
+    bool stop_ = false;
+    double rate_ = 0;
+    bool haveRate_ = false;
+    uint64_t lastBytes_ = 0;
+    std::chrono::steady_clock::time_point lastSample_;
+
+    int listenFd_ = -1;
+    std::vector<int> clients_;  // publisher thread only
+    std::thread thread_;
+};
@@ -0,0 +1,195 @@
+#include "RangeScheduler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <iterator>
+#include <thread>
+
+namespace {
+
+// Target length of one segment in time at the source's rate: long enough
+// that the startSession round trip and connection setup are noise, short
+// enough to follow a change in a gateway's throughput
+const double kSegmentSeconds = 2.0;
+
+// Weight of the latest segment in a source's smoothed rate
+const double kRateWeight = 0.5;
+
+const uint64_t kMinSegment = 1024 * 1024;
+
+uint64_t alignUp(uint64_t v, uint64_t align) {
+    return (v + align - 1) / align * align;
+}
+
+}  // namespace
+
+RangeScheduler::RangeScheduler(uint64_t start, uint64_t size, uint64_t align, uint64_t maxSegment)
+    : size_(size), align_(std::max<uint64_t>(align, 1)), maxSegment_(std::max(maxSegment, std::max<uint64_t>(align, 1))), next_(std::min(start, size)) {
+    if (next_ > 0) done_[0] = next_;
+}
+
+void RangeScheduler::addSource(const std::string& name, Fetch fetch) {
+    std::unique_ptr<Source> source(new Source);
+    source->stats.name = name;
+    source->fetch = std::move(fetch);
+    sources_.push_back(std::move(source));
+}
+
+bool RangeScheduler::run(const Sink& sink) {
+    std::vector<std::thread> threads;
+    for (auto& source : sources_) threads.emplace_back(&RangeScheduler::work, this, std::ref(*source), std::cref(sink));
+    for (std::thread& t : threads) t.join();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    return !sinkFailed_ && next_ >= size_ && retry_.empty();
+}
+
+std::vector<RangeScheduler::Stats> RangeScheduler::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<Stats> out;
+    for (const auto& source : sources_) out.push_back(source->stats);
+    return out;
+}
+
+void RangeScheduler::work(Source& source, const Sink& sink) {
+    uint64_t from = 0;
+    uint64_t to = 0;
+
+    while (take(source, from, to)) {
+        uint64_t fresh = 0;
+        const auto start = std::chrono::steady_clock::now();
+        const bool ok = source.fetch(from, to, [&](uint64_t offset, const uint8_t* data, size_t size) { return deliver(offset, data, size, sink, fresh); });
+        const double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        --inFlight_;
+        source.stats.bytes += fresh;
+        source.stats.busySeconds += secs;
+
+        if (sinkFailed_) {
+            cv_.notify_all();
+            return;
+        }
+        if (!ok) {
+            std::cerr << std::endl << "[Client] Source " << source.stats.name << " failed, handing its range to the others" << std::endl;
+            source.stats.failed = true;
+            requeueLocked(from, to);
+            cv_.notify_all();
+            return;
+        }
+
+        ++source.stats.segments;
+        if (secs > 0) {
+            const double rate = static_cast<double>(to - from) / secs;
+            source.rate = (source.rate > 0) ? source.rate + kRateWeight * (rate - source.rate) : rate;
+        }
+        cv_.notify_all();
+    }
+}
+
+bool RangeScheduler::take(Source& source, uint64_t& from, uint64_t& to) {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    // A source still fetching may fail and give its range back, so an idle one waits for it
+    while (true) {
+        if (sinkFailed_) return false;
+        if (!retry_.empty()) {
+            from = retry_.front().first;
+            to = std::min(retry_.front().second, from + segmentLocked(source));
+            if (to == retry_.front().second) retry_.pop_front();
+            else retry_.front().first = to;
+            break;
+        }
+        if (next_ < size_) {
+            from = next_;
+            to = std::min(size_, from + segmentLocked(source));
+            next_ = to;
+            break;
+        }
+        if (inFlight_ == 0) return false;
+        cv_.wait(lock);
+    }
+
+    ++inFlight_;
+    return true;
+}
+
+uint64_t RangeScheduler::segmentLocked(const Source& source) const {
+    uint64_t remaining = size_ - next_;
+    for (const auto& r : retry_) remaining += r.second - r.first;
+
+    uint32_t active = 0;
+    double known = 0;
+    uint32_t measured = 0;
+    for (const auto& s : sources_) {
+        if (s->stats.failed) continue;
+        ++active;
+        if (s->rate > 0) {
+            known += s->rate;
+            ++measured;
+        }
+    }
+    active = std::max<uint32_t>(active, 1);
+
+    double segment;
+    if (source.rate <= 0 || measured == 0) {
+        // No measurement yet: an even split, capped
+        segment = static_cast<double>(remaining) / active;
+    } else {
+        // Sources not measured yet count with the average rate of the others
+        const double total = known + (active - measured) * (known / measured);
+        segment = std::min(source.rate * kSegmentSeconds, static_cast<double>(remaining) * source.rate / total);
+    }
+
+    const uint64_t floor = std::max(align_, alignUp(kMinSegment, align_));
+    return std::min(maxSegment_, alignUp(std::max(static_cast<uint64_t>(segment), floor), align_));
+}
+
+void RangeScheduler::requeueLocked(uint64_t from, uint64_t to) {
+    // Only what never arrived goes back
+    std::lock_guard<std::mutex> lock(doneMutex_);
+    auto it = done_.upper_bound(from);
+    if (it != done_.begin()) --it;
+    uint64_t cursor = from;
+    for (; it != done_.end() && it->first < to; ++it) {
+        if (it->second <= cursor) continue;
+        if (it->first > cursor) retry_.emplace_back(cursor, it->first);
+        cursor = std::max(cursor, it->second);
+    }
+    if (cursor < to) retry_.emplace_back(cursor, to);
+}
+
+bool RangeScheduler::deliver(uint64_t offset, const uint8_t* data, size_t size, const Sink& sink, uint64_t& fresh) {
+    const uint64_t end = offset + size;
+    std::vector<std::pair<uint64_t, uint64_t>> claimed;
+
+    // Claims the parts nobody delivered yet, so each byte reaches the sink once
+    {
+        std::lock_guard<std::mutex> lock(doneMutex_);
+        uint64_t start = offset;
+        uint64_t stop = end;
+        auto it = done_.upper_bound(offset);
+        if (it != done_.begin() && std::prev(it)->second >= offset) --it;
+
+        uint64_t cursor = offset;
+        while (it != done_.end() && it->first <= end) {
+            if (it->first > cursor) claimed.emplace_back(cursor, it->first);
+            cursor = std::max(cursor, it->second);
+            start = std::min(start, it->first);
+            stop = std::max(stop, it->second);
+            it = done_.erase(it);
+        }
+        if (cursor < end) claimed.emplace_back(cursor, end);
+        done_[start] = stop;
+    }
+
+    for (const auto& r : claimed) {
+        if (sinkFailed_ || !sink(r.first, data + (r.first - offset), static_cast<size_t>(r.second - r.first))) {
+            sinkFailed_ = true;
+            return false;
+        }
+        fresh += r.second - r.first;
+    }
+    return true;
+}
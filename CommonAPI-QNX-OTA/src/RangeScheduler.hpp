@@ -0,0 +1,83 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Splits one image between several gateways serving it and pulls disjoint
+// ranges from all of them at once. Each source runs on its own thread and
+// takes one segment at a time: about kSegmentSeconds of data at the rate
+// it achieved so far, at most `maxSegment` bytes, and never more than its
+// share of what is left by throughput. A faster source therefore comes
+// back for more sooner and gets larger segments, and towards the end the
+// segments shrink so all sources finish at about the same time.
+//
+// A source that fails is dropped and the unreceived part of its segment
+// goes back to the others. Pieces are forwarded to the sink at most once,
+// so overlapping deliveries (a gateway rounding a range to its chunk size,
+// a retried segment) are not written twice. A sink that fails stops every
+// source, since the fault is local and no other gateway can fix it.
+class RangeScheduler {
+   public:
+    typedef std::function<bool(uint64_t offset, const uint8_t* data, size_t size)> Sink;
+
+    // Transfers bytes [from, to) of the image from one source into `sink`;
+    // returns false if the source failed
+    typedef std::function<bool(uint64_t from, uint64_t to, const Sink& sink)> Fetch;
+
+    struct Stats {
+        std::string name;
+        uint64_t bytes = 0;       // new bytes delivered
+        uint32_t segments = 0;
+        double busySeconds = 0;   // time spent fetching
+        bool failed = false;
+    };
+
+    // Segments are aligned to `align` bytes and at most `maxSegment` long;
+    // bytes [start, size) are to be fetched
+    RangeScheduler(uint64_t start, uint64_t size, uint64_t align, uint64_t maxSegment);
+
+    void addSource(const std::string& name, Fetch fetch);
+
+    // Runs every source until the whole range reached `sink`. False if some
+    // of it could not be fetched because every source failed, or the sink failed.
+    bool run(const Sink& sink);
+
+    std::vector<Stats> stats() const;
+
+   private:
+    struct Source {
+        Stats stats;
+        Fetch fetch;
+        double rate = 0;  // bytes/s, smoothed over segments; 0 until the first one
+    };
+
+    void work(Source& source, const Sink& sink);
+    bool take(Source& source, uint64_t& from, uint64_t& to);
+    uint64_t segmentLocked(const Source& source) const;
+    void requeueLocked(uint64_t from, uint64_t to);
+    bool deliver(uint64_t offset, const uint8_t* data, size_t size, const Sink& sink, uint64_t& fresh);
+
+    const uint64_t size_;
+    const uint64_t align_;
+    const uint64_t maxSegment_;
+
+    mutable std::mutex mutex_;  // guards the work below and the sources' stats and rates
+    std::condition_variable cv_;
+    std::vector<std::unique_ptr<Source>> sources_;
+    uint64_t next_;                                     // first byte not handed out yet
+    std::deque<std::pair<uint64_t, uint64_t>> retry_;  // ranges given back by a failed source
+    uint32_t inFlight_ = 0;
+    std::atomic<bool> sinkFailed_{false};
+
+    std::mutex doneMutex_;
+    std::map<uint64_t, uint64_t> done_;  // delivered ranges, start -> end, merged
+};
@@ -0,0 +1,239 @@
+#include "ResumeState.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+#include "ota/Checksum.hpp"
+
+namespace {
+
+// "FTRS" + format version. Layout after it, little endian:
+//   size u64, crc u32, sha256 (u16 length + bytes), output (u16 length + bytes),
+//   unitSize u32, unitCount u32, bitmap (unitCount bits), crc u32 per set bit,
+//   then a CRC32 of everything before it.
+const uint8_t kMagic[8] = {'F', 'T', 'R', 'S', 0, 0, 0, 1};
+
+void putU16(std::vector<uint8_t>& out, uint16_t v) {
+    out.push_back(static_cast<uint8_t>(v));
+    out.push_back(static_cast<uint8_t>(v >> 8));
+}
+
+void putU32(std::vector<uint8_t>& out, uint32_t v) {
+    for (int i = 0; i < 4; ++i) out.push_back(static_cast<uint8_t>(v >> (i * 8)));
+}
+
+void putU64(std::vector<uint8_t>& out, uint64_t v) {
+    for (int i = 0; i < 8; ++i) out.push_back(static_cast<uint8_t>(v >> (i * 8)));
+}
+
+void putString(std::vector<uint8_t>& out, const std::string& s) {
+    putU16(out, static_cast<uint16_t>(s.size()));
+    out.insert(out.end(), s.begin(), s.end());
+}
+
+uint32_t crcOf(const uint8_t* data, size_t size) {
+    Crc32 crc;
+    crc.update(data, size);
+    return crc.value();
+}
+
+// Bounds-checked little-endian reader over the loaded file
+struct Cursor {
+    const uint8_t* p;
+    size_t left;
+
+    bool get(uint64_t& v, int bytes) {
+        if (left < static_cast<size_t>(bytes)) return false;
+        v = 0;
+        for (int i = bytes - 1; i >= 0; --i) v = (v << 8) | p[i];
+        p += bytes;
+        left -= static_cast<size_t>(bytes);
+        return true;
+    }
+
+    bool getString(std::string& s) {
+        uint64_t n = 0;
+        if (!get(n, 2) || left < n) return false;
+        s.assign(reinterpret_cast<const char*>(p), static_cast<size_t>(n));
+        p += n;
+        left -= static_cast<size_t>(n);
+        return true;
+    }
+};
+
+bool writeAll(int fd, const uint8_t* data, size_t size) {
+    while (size > 0) {
+        ssize_t n = ::write(fd, data, size);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        data += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+void syncDir(const std::string& path) {
+    std::string::size_type slash = path.rfind('/');
+    std::string dir = (slash == std::string::npos) ? "." : path.substr(0, slash);
+    int fd = ::open(dir.c_str(), O_RDONLY);
+    if (fd < 0) return;
+    fsync(fd);
+    close(fd);
+}
+
+}  // namespace
+
+ResumeState::ResumeState(const std::string& path) : path_(path) {}
+
+bool ResumeState::load(const Identity& identity) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    identity_ = identity;
+    unitSize_ = 0;
+    have_.clear();
+    crcs_.clear();
+
+    std::ifstream in(path_.c_str(), std::ios::binary);
+    if (!in) return false;
+    std::vector<uint8_t> buf((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    if (buf.size() < sizeof(kMagic) + 4 || std::memcmp(buf.data(), kMagic, sizeof(kMagic)) != 0) {
+        std::cerr << "[Client] Resume state " << path_ << " has an unknown format, ignoring it" << std::endl;
+        return false;
+    }
+    const size_t body = buf.size() - 4;
+    Cursor trailer{buf.data() + body, 4};
+    uint64_t sum = 0;
+    if (!trailer.get(sum, 4) || crcOf(buf.data(), body) != sum) {
+        std::cerr << "[Client] Resume state " << path_ << " is corrupt, ignoring it" << std::endl;
+        return false;
+    }
+
+    Cursor c{buf.data() + sizeof(kMagic), body - sizeof(kMagic)};
+    Identity saved;
+    uint64_t crc = 0, unitSize = 0, unitCount = 0;
+    if (!c.get(saved.size, 8) || !c.get(crc, 4) || !c.getString(saved.sha256) || !c.getString(saved.output) || !c.get(unitSize, 4) ||
+        !c.get(unitCount, 4) || c.left < (unitCount + 7) / 8)
+        return false;
+    saved.crc = static_cast<uint32_t>(crc);
+    if (!(saved == identity)) return false;
+
+    const uint8_t* bitmap = c.p;
+    c.p += (unitCount + 7) / 8;
+    c.left -= static_cast<size_t>((unitCount + 7) / 8);
+
+    std::vector<bool> have(static_cast<size_t>(unitCount), false);
+    std::vector<uint32_t> crcs(static_cast<size_t>(unitCount), 0);
+    for (uint32_t u = 0; u < unitCount; ++u) {
+        if (!(bitmap[u / 8] & (1u << (u % 8)))) continue;
+        uint64_t v = 0;
+        if (!c.get(v, 4)) return false;
+        have[u] = true;
+        crcs[u] = static_cast<uint32_t>(v);
+    }
+
+    unitSize_ = static_cast<uint32_t>(unitSize);
+    have_.swap(have);
+    crcs_.swap(crcs);
+    return true;
+}
+
+void ResumeState::reset(const Identity& identity, uint32_t unitSize) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    identity_ = identity;
+    unitSize_ = unitSize;
+    const size_t units = unitSize ? static_cast<size_t>((identity.size + unitSize - 1) / unitSize) : 0;
+    have_.assign(units, false);
+    crcs_.assign(units, 0);
+}
+
+uint32_t ResumeState::unitSize() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return unitSize_;
+}
+
+bool ResumeState::get(uint32_t unit, uint32_t& crc) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (unit >= have_.size() || !have_[unit]) return false;
+    crc = crcs_[unit];
+    return true;
+}
+
+void ResumeState::mark(uint32_t unit, uint32_t crc) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (unit >= have_.size()) return;
+    have_[unit] = true;
+    crcs_[unit] = crc;
+}
+
+void ResumeState::truncate(uint32_t unit) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t u = unit; u < have_.size(); ++u) have_[u] = false;
+}
+
+bool ResumeState::checkpoint(const std::function<bool()>& flush) {
+    // Taken before the flush: everything it lists was handed to the writer already
+    std::vector<uint8_t> data;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (unitSize_ == 0) return false;
+        data = encodeLocked();
+    }
+    if (!flush()) return false;
+    return write(data);
+}
+
+uint32_t ResumeState::unitCrc(const uint8_t* data, size_t size) {
+    return crcOf(data, size);
+}
+
+void ResumeState::remove() {
+    if (::unlink(path_.c_str()) == 0) syncDir(path_);
+}
+
+std::vector<uint8_t> ResumeState::encodeLocked() const {
+    std::vector<uint8_t> out(kMagic, kMagic + sizeof(kMagic));
+    putU64(out, identity_.size);
+    putU32(out, identity_.crc);
+    putString(out, identity_.sha256);
+    putString(out, identity_.output);
+    putU32(out, unitSize_);
+    putU32(out, static_cast<uint32_t>(have_.size()));
+
+    std::vector<uint8_t> bitmap((have_.size() + 7) / 8, 0);
+    for (size_t u = 0; u < have_.size(); ++u) {
+        if (have_[u]) bitmap[u / 8] |= static_cast<uint8_t>(1u << (u % 8));
+    }
+    out.insert(out.end(), bitmap.begin(), bitmap.end());
+    for (size_t u = 0; u < have_.size(); ++u) {
+        if (have_[u]) putU32(out, crcs_[u]);
+    }
+
+    putU32(out, crcOf(out.data(), out.size()));
+    return out;
+}
+
+bool ResumeState::write(const std::vector<uint8_t>& data) {
+    const std::string tmp = path_ + ".tmp";
+    int fd = ::open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        std::cerr << std::endl << "[Client] Cannot create resume state " << tmp << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    bool ok = writeAll(fd, data.data(), data.size()) && fsync(fd) == 0;
+    close(fd);
+    if (!ok || rename(tmp.c_str(), path_.c_str()) != 0) {
+        std::cerr << std::endl << "[Client] Cannot write resume state " << path_ << ": " << std::strerror(errno) << std::endl;
+        unlink(tmp.c_str());
+        return false;
+    }
+    syncDir(path_);
+    return true;
+}
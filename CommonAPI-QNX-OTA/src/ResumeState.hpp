@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Sidecar of a partially received image, so a client that lost power picks
+// up where it was instead of downloading everything again. It records which
+// image is being written (size and published hashes) and where, the unit
+// size (the session's chunk size), and for every unit that reached the
+// output its CRC32, so each one can be checked against the bytes actually
+// on disk before it is trusted.
+//
+// The file is replaced atomically (temporary file, fsync, rename), and a
+// checkpoint only records units whose data was flushed before it: a power
+// cut leaves either the previous or the new state, never a torn one.
+class ResumeState {
+   public:
+    struct Identity {
+        uint64_t size = 0;
+        uint32_t crc = 0;
+        std::string sha256;
+        std::string output;
+
+        bool operator==(const Identity& other) const {
+            return size == other.size && crc == other.crc && sha256 == other.sha256 && output == other.output;
+        }
+    };
+
+    explicit ResumeState(const std::string& path);
+
+    ResumeState(const ResumeState&) = delete;
+    ResumeState& operator=(const ResumeState&) = delete;
+
+    // Loads the sidecar; false if there is none, it is corrupt, or it
+    // describes another image or output. The state is empty on false.
+    bool load(const Identity& identity);
+
+    // Starts over for `identity` in units of `unitSize` bytes (0: not known yet)
+    void reset(const Identity& identity, uint32_t unitSize);
+
+    uint32_t unitSize() const;
+
+    // CRC32 recorded for `unit`, false if it was never received
+    bool get(uint32_t unit, uint32_t& crc) const;
+
+    // Records `unit` as written with content `crc`. Thread-safe.
+    void mark(uint32_t unit, uint32_t crc);
+
+    // Forgets every unit from `unit` on
+    void truncate(uint32_t unit);
+
+    // Runs `flush` to make the units marked so far durable, then persists
+    // them. Units marked while `flush` runs wait for the next checkpoint.
+    bool checkpoint(const std::function<bool()>& flush);
+
+    // Deletes the sidecar, e.g. once the image is complete
+    void remove();
+
+    const std::string& path() const { return path_; }
+
+    // Checksum recorded per unit (CRC32 of its bytes)
+    static uint32_t unitCrc(const uint8_t* data, size_t size);
+
+   private:
+    std::vector<uint8_t> encodeLocked() const;
+    bool write(const std::vector<uint8_t>& data);
+
+    std::string path_;
+
+    mutable std::mutex mutex_;
+    Identity identity_;
+    uint32_t unitSize_ = 0;
+    std::vector<bool> have_;
+    std::vector<uint32_t> crcs_;
+};
@@ -0,0 +1,238 @@
+#include "SessionJournal.hpp"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+
+namespace {
+
+const uint8_t kMagic[8] = {'F', 'T', 'S', 'J', 0, 0, 0, 1};  // "FTSJ" + format version
+
+uint32_t fnv1a32(const uint8_t* data, size_t size) {
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < size; ++i) {
+        h ^= data[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+void putU16(std::vector<uint8_t>& out, uint16_t v) {
+    out.push_back(static_cast<uint8_t>(v));
+    out.push_back(static_cast<uint8_t>(v >> 8));
+}
+
+void putU32(std::vector<uint8_t>& out, uint32_t v) {
+    for (int i = 0; i < 4; ++i) out.push_back(static_cast<uint8_t>(v >> (i * 8)));
+}
+
+void putU64(std::vector<uint8_t>& out, uint64_t v) {
+    for (int i = 0; i < 8; ++i) out.push_back(static_cast<uint8_t>(v >> (i * 8)));
+}
+
+uint64_t getLE(const uint8_t* p, int bytes) {
+    uint64_t v = 0;
+    for (int i = bytes - 1; i >= 0; --i) v = (v << 8) | p[i];
+    return v;
+}
+
+bool writeAll(int fd, const uint8_t* data, size_t size) {
+    while (size > 0) {
+        ssize_t n = write(fd, data, size);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        data += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+std::vector<uint8_t> frame(uint8_t type, const std::vector<uint8_t>& payload) {
+    std::vector<uint8_t> rec;
+    rec.reserve(payload.size() + 7);
+    rec.push_back(type);
+    putU16(rec, static_cast<uint16_t>(payload.size()));
+    rec.insert(rec.end(), payload.begin(), payload.end());
+    putU32(rec, fnv1a32(rec.data(), rec.size()));
+    return rec;
+}
+
+void syncDir(const std::string& path) {
+    std::string::size_type slash = path.rfind('/');
+    std::string dir = (slash == std::string::npos) ? "." : path.substr(0, slash);
+    int fd = ::open(dir.c_str(), O_RDONLY);
+    if (fd < 0) return;
+    fsync(fd);
+    close(fd);
+}
+
+}  // namespace
+
+SessionJournal::SessionJournal(const std::string& path, unsigned syncIntervalMs) : path_(path), syncIntervalMs_(syncIntervalMs) {}
+
+SessionJournal::~SessionJournal() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    cv_.notify_all();
+    if (syncThread_.joinable()) syncThread_.join();
+
+    if (fd_ >= 0) {
+        fdatasync(fd_);
+        close(fd_);
+    }
+}
+
+std::vector<uint8_t> SessionJournal::encodeOpen(const Entry& entry) {
+    std::vector<uint8_t> p;
+    putU32(p, entry.sessionId);
+    putU64(p, entry.imageId);
+    putU32(p, entry.chunkCount);
+    putU32(p, entry.acked);
+    putU16(p, static_cast<uint16_t>(entry.clientId.size()));
+    p.insert(p.end(), entry.clientId.begin(), entry.clientId.end());
+    putU32(p, entry.chunkSize);
+    putU64(p, static_cast<uint64_t>(entry.updatedAt));
+    return p;
+}
+
+bool SessionJournal::open(std::vector<Entry>& sessions) {
+    std::map<uint32_t, Entry> live;
+
+    std::ifstream in(path_.c_str(), std::ios::binary);
+    if (in) {
+        std::vector<uint8_t> buf((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        size_t pos = sizeof(kMagic);
+
+        if (buf.size() < pos || std::memcmp(buf.data(), kMagic, sizeof(kMagic)) != 0) {
+            std::cerr << "[Service] Journal " << path_ << " has an unknown format, starting empty" << std::endl;
+            pos = buf.size();
+        }
+
+        while (pos + 3 <= buf.size()) {
+            const uint8_t* rec = buf.data() + pos;
+            const size_t len = static_cast<size_t>(getLE(rec + 1, 2));
+            if (pos + 3 + len + 4 > buf.size()) break;  // torn tail
+            if (fnv1a32(rec, 3 + len) != getLE(rec + 3 + len, 4)) break;
+
+            const uint8_t* p = rec + 3;
+            if (rec[0] == kOpen && len >= 22) {
+                Entry e;
+                e.sessionId = static_cast<uint32_t>(getLE(p, 4));
+                e.imageId = getLE(p + 4, 8);
+                e.chunkCount = static_cast<uint32_t>(getLE(p + 12, 4));
+                e.acked = static_cast<uint32_t>(getLE(p + 16, 4));
+                size_t idLen = static_cast<size_t>(getLE(p + 20, 2));
+                if (22 + idLen <= len) e.clientId.assign(reinterpret_cast<const char*>(p + 22), idLen);
+                // Records written before chunk sizes were configurable end after the client id
+                if (22 + idLen + 4 <= len) e.chunkSize = static_cast<uint32_t>(getLE(p + 22 + idLen, 4));
+                if (22 + idLen + 12 <= len) e.updatedAt = static_cast<int64_t>(getLE(p + 22 + idLen + 4, 8));
+                live[e.sessionId] = e;
+                if (e.sessionId > lastSessionId_) lastSessionId_ = e.sessionId;
+            } else if (rec[0] == kAck && len >= 8) {
+                auto it = live.find(static_cast<uint32_t>(getLE(p, 4)));
+                if (it != live.end()) {
+                    it->second.acked = static_cast<uint32_t>(getLE(p + 4, 4));
+                    if (len >= 16) it->second.updatedAt = static_cast<int64_t>(getLE(p + 8, 8));
+                }
+            } else if (rec[0] == kClose && len >= 4) {
+                live.erase(static_cast<uint32_t>(getLE(p, 4)));
+            }
+
+            pos += 3 + len + 4;
+        }
+    }
+
+    // Compact: rewrite the journal with one open record per live session
+    const std::string tmp = path_ + ".tmp";
+    int fd = ::open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        std::cerr << "[Service] Cannot create journal " << tmp << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    std::vector<uint8_t> out(kMagic, kMagic + sizeof(kMagic));
+    for (const auto& kv : live) {
+        std::vector<uint8_t> rec = frame(kOpen, encodeOpen(kv.second));
+        out.insert(out.end(), rec.begin(), rec.end());
+        sessions.push_back(kv.second);
+    }
+
+    bool ok = writeAll(fd, out.data(), out.size()) && fsync(fd) == 0;
+    close(fd);
+    if (!ok || rename(tmp.c_str(), path_.c_str()) != 0) {
+        std::cerr << "[Service] Cannot write journal " << path_ << ": " << std::strerror(errno) << std::endl;
+        unlink(tmp.c_str());
+        return false;
+    }
+    syncDir(path_);
+
+    fd_ = ::open(path_.c_str(), O_WRONLY | O_APPEND);
+    if (fd_ < 0) return false;
+
+    syncThread_ = std::thread(&SessionJournal::syncLoop, this);
+    return true;
+}
+
+void SessionJournal::recordOpen(const Entry& entry) {
+    Entry stamped = entry;
+    stamped.updatedAt = static_cast<int64_t>(std::time(nullptr));
+    append(kOpen, encodeOpen(stamped), true);
+}
+
+void SessionJournal::recordAck(uint32_t sessionId, uint32_t acked) {
+    std::vector<uint8_t> p;
+    putU32(p, sessionId);
+    putU32(p, acked);
+    putU64(p, static_cast<uint64_t>(std::time(nullptr)));
+    append(kAck, p, false);
+}
+
+void SessionJournal::recordClose(uint32_t sessionId) {
+    std::vector<uint8_t> p;
+    putU32(p, sessionId);
+    append(kClose, p, true);
+}
+
+void SessionJournal::append(RecordType type, const std::vector<uint8_t>& payload, bool sync) {
+    std::vector<uint8_t> rec = frame(type, payload);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (fd_ < 0) return;
+
+    if (!writeAll(fd_, rec.data(), rec.size())) {
+        std::cerr << "[Service] Journal write failed: " << std::strerror(errno) << std::endl;
+        return;
+    }
+
+    if (sync) {
+        fdatasync(fd_);
+        dirty_ = false;
+    } else {
+        dirty_ = true;
+    }
+}
+
+void SessionJournal::syncLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stop_) {
+        cv_.wait_for(lock, std::chrono::milliseconds(syncIntervalMs_), [this] { return stop_; });
+        if (dirty_ && fd_ >= 0) {
+            // One fsync covers every ack appended since the last one; appends may continue meanwhile
+            dirty_ = false;
+            lock.unlock();
+            fdatasync(fd_);
+            lock.lock();
+        }
+    }
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Append-only log of event-path transfer sessions, so a gateway restart can
+// pick up in-flight rollouts where the clients left off. Each record is
+// [type u8][length u16][payload][fnv1a32 u32]; a torn or corrupt tail is
+// dropped on replay. Opens and closes are synced immediately, acks are
+// written straight away but fsync'ed in batches by a background thread.
+class SessionJournal {
+   public:
+    struct Entry {
+        uint32_t sessionId = 0;
+        std::string clientId;
+        uint64_t imageId = 0;
+        uint32_t chunkSize = 64 * 1024;
+        uint32_t chunkCount = 0;
+        uint32_t acked = 0;  // chunks [0, acked) confirmed by the client
+        int64_t updatedAt = 0;  // unix time of the open or the last ack; 0 in journals written before it was kept
+    };
+
+    SessionJournal(const std::string& path, unsigned syncIntervalMs);
+    ~SessionJournal();
+
+    SessionJournal(const SessionJournal&) = delete;
+    SessionJournal& operator=(const SessionJournal&) = delete;
+
+    // Replays the journal, rewrites it to hold only the open sessions and
+    // returns them. Must be called once before any record*().
+    bool open(std::vector<Entry>& sessions);
+
+    // Opens and acks are stamped with the current time
+    void recordOpen(const Entry& entry);
+    void recordAck(uint32_t sessionId, uint32_t acked);
+    void recordClose(uint32_t sessionId);
+
+    // Largest session id ever journaled, so new ids never collide with a replayed one
+    uint32_t lastSessionId() const { return lastSessionId_; }
+
+   private:
+    enum RecordType : uint8_t { kOpen = 1, kAck = 2, kClose = 3 };
+
+    void append(RecordType type, const std::vector<uint8_t>& payload, bool sync);
+    void syncLoop();
+
+    static std::vector<uint8_t> encodeOpen(const Entry& entry);
+
+    std::string path_;
+    unsigned syncIntervalMs_;
+    int fd_ = -1;
+    uint32_t lastSessionId_ = 0;
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool dirty_ = false;
+    bool stop_ = false;
+    std::thread syncThread_;
+};
@@ -0,0 +1,265 @@
+#include "ShmRing.hpp"
+
+#include <fcntl.h>
+#include <semaphore.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <thread>
+
+namespace {
+
+const uint32_t kRingMagic = 0x46545352;  // "FTSR"
+const uint64_t kDoorbellTimeoutMs = 30000;  // producer side: how long a silent consumer is waited for
+
+struct RingHeader {
+    uint32_t magic;
+    uint32_t slotCount;
+    uint32_t slotSize;
+    uint32_t reserved;
+    uint64_t totalLength;
+    std::atomic<uint32_t> aborted;
+    sem_t filled;  // slots ready for the consumer
+    sem_t free;    // slots the producer may reuse
+};
+
+struct SlotDescriptor {
+    uint64_t offset;
+    uint32_t length;
+    uint32_t last;
+};
+
+size_t alignUp(size_t v, size_t a) { return (v + a - 1) / a * a; }
+
+size_t headerBytes() { return alignUp(sizeof(RingHeader), 64); }
+
+size_t slotStride(uint32_t slotSize) { return alignUp(sizeof(SlotDescriptor) + slotSize, 64); }
+
+SlotDescriptor* slotAt(void* base, const RingHeader* h, uint64_t seq) {
+    uint8_t* p = static_cast<uint8_t*>(base) + headerBytes() + (seq % h->slotCount) * slotStride(h->slotSize);
+    return reinterpret_cast<SlotDescriptor*>(p);
+}
+
+uint8_t* payloadOf(SlotDescriptor* d) { return reinterpret_cast<uint8_t*>(d) + sizeof(SlotDescriptor); }
+
+// Waits on a doorbell, giving up if the peer aborted or stayed silent for `timeoutMs` (0: waits forever)
+bool ring(sem_t* sem, RingHeader* h, uint64_t timeoutMs) {
+    if (timeoutMs == 0) {
+        while (sem_wait(sem) != 0) {
+            if (errno != EINTR) return false;
+        }
+        return h->aborted.load() == 0;
+    }
+
+    timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += static_cast<time_t>(timeoutMs / 1000);
+    deadline.tv_nsec += static_cast<long>((timeoutMs % 1000) * 1000000);
+    if (deadline.tv_nsec >= 1000000000L) {
+        ++deadline.tv_sec;
+        deadline.tv_nsec -= 1000000000L;
+    }
+
+    while (sem_timedwait(sem, &deadline) != 0) {
+        if (errno != EINTR) return false;
+    }
+    return h->aborted.load() == 0;
+}
+
+}  // namespace
+
+ShmRingServer::ShmRingServer(uint32_t slotCount, uint32_t slotSize)
+    : slotCount_(slotCount ? slotCount : 1), slotSize_(slotSize ? slotSize : 1), rng_(std::random_device{}()) {}
+
+std::string ShmRingServer::offer(const std::string& path) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return "";
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return "";
+    }
+
+    char name[32];
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::snprintf(name, sizeof(name), "/ft-%016llx", static_cast<unsigned long long>(rng_()));
+    }
+
+    const size_t mapSize = headerBytes() + slotCount_ * slotStride(slotSize_);
+
+    int shm = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (shm < 0 || ftruncate(shm, static_cast<off_t>(mapSize)) != 0) {
+        std::cerr << "[Service] Shared memory ring: cannot create " << name << ": " << std::strerror(errno) << std::endl;
+        if (shm >= 0) {
+            close(shm);
+            shm_unlink(name);
+        }
+        close(fd);
+        return "";
+    }
+
+    void* base = mmap(nullptr, mapSize, PROT_READ | PROT_WRITE, MAP_SHARED, shm, 0);
+    close(shm);
+    if (base == MAP_FAILED) {
+        shm_unlink(name);
+        close(fd);
+        return "";
+    }
+
+    RingHeader* h = new (base) RingHeader;
+    h->slotCount = slotCount_;
+    h->slotSize = slotSize_;
+    h->reserved = 0;
+    h->totalLength = static_cast<uint64_t>(st.st_size);
+    h->aborted.store(0);
+    sem_init(&h->filled, 1, 0);
+    sem_init(&h->free, 1, slotCount_);
+    h->magic = kRingMagic;
+
+    std::thread(&ShmRingServer::produce, std::string(name), base, mapSize, fd).detach();
+
+    return std::string("shm://") + name;
+}
+
+void ShmRingServer::produce(std::string name, void* base, size_t mapSize, int fd) {
+    RingHeader* h = static_cast<RingHeader*>(base);
+    const auto start = std::chrono::steady_clock::now();
+
+    uint64_t offset = 0;
+    uint64_t seq = 0;
+    bool ok = true;
+
+    // Always publish at least one slot so an empty image still completes
+    do {
+        if (!ring(&h->free, h, kDoorbellTimeoutMs)) {
+            ok = false;
+            break;
+        }
+
+        SlotDescriptor* d = slotAt(base, h, seq++);
+        uint64_t want = std::min<uint64_t>(h->slotSize, h->totalLength - offset);
+        size_t got = 0;
+        while (got < want) {
+            ssize_t n = pread(fd, payloadOf(d) + got, static_cast<size_t>(want - got), static_cast<off_t>(offset + got));
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) break;
+            got += static_cast<size_t>(n);
+        }
+        if (got < want) {
+            ok = false;
+            break;
+        }
+
+        d->offset = offset;
+        d->length = static_cast<uint32_t>(want);
+        offset += want;
+        d->last = (offset >= h->totalLength) ? 1 : 0;
+
+        sem_post(&h->filled);
+    } while (offset < h->totalLength);
+
+    // Keep the segment linked until the consumer has drained every slot
+    for (uint32_t i = 0; ok && i < h->slotCount; ++i) ok = ring(&h->free, h, kDoorbellTimeoutMs);
+
+    if (ok) {
+        double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "[Service] Shared memory ring: streamed " << offset << " bytes in " << secs << " s ("
+                  << (secs > 0 ? offset / secs / (1024 * 1024) : 0) << " MB/s)" << std::endl;
+    } else {
+        h->aborted.store(1);
+        sem_post(&h->filled);
+        std::cerr << "[Service] Shared memory ring " << name << " aborted after " << offset << " bytes" << std::endl;
+    }
+
+    close(fd);
+    munmap(base, mapSize);
+    shm_unlink(name.c_str());
+}
+
+bool ShmRingClient::receive(const std::string& endpoint, const Sink& sink, bool& attached, uint64_t idleTimeoutMs) {
+    attached = false;
+    const std::string scheme = "shm://";
+    if (endpoint.compare(0, scheme.size(), scheme) != 0) return false;
+    const std::string name = endpoint.substr(scheme.size());
+
+    int shm = shm_open(name.c_str(), O_RDWR, 0);
+    if (shm < 0) {
+        std::cerr << "[Client] Cannot open shared memory ring " << name << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(shm, &st) != 0 || static_cast<size_t>(st.st_size) < headerBytes()) {
+        close(shm);
+        return false;
+    }
+
+    const size_t mapSize = static_cast<size_t>(st.st_size);
+    void* base = mmap(nullptr, mapSize, PROT_READ | PROT_WRITE, MAP_SHARED, shm, 0);
+    close(shm);
+    if (base == MAP_FAILED) return false;
+
+    RingHeader* h = static_cast<RingHeader*>(base);
+    bool ok = (h->magic == kRingMagic) && mapSize >= headerBytes() + h->slotCount * slotStride(h->slotSize);
+    if (!ok) {
+        std::cerr << "[Client] " << name << " is not a shared memory ring" << std::endl;
+        munmap(base, mapSize);
+        return false;
+    }
+    attached = true;
+
+    for (uint64_t seq = 0; ok; ++seq) {
+        if (!ring(&h->filled, h, idleTimeoutMs)) {
+            std::cerr << "[Client] Shared memory ring stalled" << std::endl;
+            ok = false;
+            break;
+        }
+
+        SlotDescriptor* d = slotAt(base, h, seq);
+        const bool last = d->last != 0;
+        if (d->length && !sink(d->offset, payloadOf(d), d->length)) {
+            ok = false;
+            break;
+        }
+        sem_post(&h->free);
+
+        if (last) break;
+    }
+
+    if (!ok) h->aborted.store(1);
+
+    munmap(base, mapSize);
+    return ok;
+}
+
+std::string localHostId() {
+#if defined(__linux__)
+    std::ifstream in("/proc/sys/kernel/random/boot_id");
+    std::string id;
+    if (std::getline(in, id) && !id.empty()) {
+        struct stat ipc, shm;
+        std::ostringstream full;
+        full << id;
+        if (stat("/proc/self/ns/ipc", &ipc) == 0) full << "/ipc:" << ipc.st_ino;
+        if (stat("/dev/shm", &shm) == 0) full << "/shm:" << shm.st_dev << ":" << shm.st_ino;
+        return full.str();
+    }
+#endif
+    char host[256] = {0};
+    if (gethostname(host, sizeof(host) - 1) != 0) return "";
+    return host;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <random>
+#include <string>
+
+// Shared-memory data plane for a client running on the same host as the
+// server. The image is copied into a ring of fixed-size slots in a POSIX shm
+// segment; each slot starts with a descriptor (offset, length, last) so
+// SOME/IP only has to carry the segment name ("shm:///<name>"). Doorbells are
+// process-shared semaphores in the segment (futex-backed on Linux, native on
+// QNX), so the transfer rate is bounded by memcpy rather than the network stack.
+
+class ShmRingServer {
+   public:
+    ShmRingServer(uint32_t slotCount, uint32_t slotSize);
+
+    // Creates a ring for `path`, starts its producer thread and returns the endpoint, or "" on failure
+    std::string offer(const std::string& path);
+
+   private:
+    static void produce(std::string name, void* base, size_t mapSize, int fd);
+
+    uint32_t slotCount_;
+    uint32_t slotSize_;
+
+    std::mutex mutex_;
+    std::mt19937_64 rng_;
+};
+
+class ShmRingClient {
+   public:
+    // Receives payload pieces at their image offset, in ring order; false aborts the transfer
+    typedef std::function<bool(uint64_t offset, const uint8_t* data, size_t size)> Sink;
+
+    // `attached` is false if the ring could not be opened at all (another
+    // container's /dev/shm, another uid); nothing reached the sink then, and
+    // the transfer can be asked for again without the ring. The transfer
+    // fails if no slot is filled for `idleTimeoutMs` (0: waits forever).
+    static bool receive(const std::string& endpoint, const Sink& sink, bool& attached, uint64_t idleTimeoutMs = 0);
+};
+
+// Identity of this host for the same-host check: kernel boot id plus the IPC
+// namespace and /dev/shm instance on Linux, hostname elsewhere. Containers
+// share the boot id but not necessarily the place shm_open() looks.
+std::string localHostId();
@@ -0,0 +1,59 @@
+#include "SlotInstaller.hpp"
+
+#include <unistd.h>
+
+#include <iostream>
+#include <stdexcept>
+
+bool SlotInstaller::prepare(const Config& config) {
+    config_ = config;
+
+    try {
+        Slot active;
+        if (!detectActiveSlotFromCmdline(readTextFile(config.cmdlinePath), active)) {
+            std::cerr << "[Client] Cannot determine the active slot from " << config.cmdlinePath << std::endl;
+            return false;
+        }
+        plan_ = buildPlan(active, config.layout);
+
+        // Fail before downloading anything if the flip could not be written
+        bootconf_ = updateExtlinuxRootPartlabel(readTextFile(config.bootconfPath), plan_.targetLabel);
+    } catch (const std::exception& e) {
+        std::cerr << "[Client] Slot setup failed: " << e.what() << std::endl;
+        return false;
+    }
+
+    std::cout << "[Client] Active slot " << ((plan_.active == Slot::A) ? "A" : "B") << ", streaming into " << plan_.targetDev << " ("
+              << plan_.targetLabel << ")" << std::endl;
+    return true;
+}
+
+bool SlotInstaller::fits(uint64_t imageSize) const {
+    uint64_t slotBytes = 0;
+    try {
+        slotBytes = blockDeviceSizeBytes(plan_.targetDev);
+    } catch (const std::exception& e) {
+        std::cerr << "[Client] " << e.what() << std::endl;
+        return false;
+    }
+
+    if (imageSize > slotBytes) {
+        std::cerr << "[Client] Image (" << imageSize << " bytes) does not fit slot " << plan_.targetDev << " (" << slotBytes << " bytes)"
+                  << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool SlotInstaller::commit() {
+    try {
+        atomicWriteFile(config_.bootconfPath, bootconf_);
+    } catch (const std::exception& e) {
+        std::cerr << "[Client] Boot flip failed: " << e.what() << std::endl;
+        return false;
+    }
+    sync();
+
+    std::cout << "[Client] Boot config " << config_.bootconfPath << " now points at " << plan_.targetLabel << std::endl;
+    return true;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "ota/Slot.hpp"
+
+// Direct-to-slot mode of the client ([transfer] target=slot): the image is
+// streamed straight into the inactive A/B partition that ota-apply would
+// have written, so it is stored once instead of twice and needs no free
+// space in data/client/. The boot flip is prepared before the download and
+// only written once the image in the slot has been verified.
+class SlotInstaller {
+   public:
+    struct Config {
+        std::string cmdlinePath = "/proc/cmdline";
+        std::string bootconfPath = "/boot/extlinux/extlinux.conf";
+        SlotLayout layout = SlotLayout::defaults();
+    };
+
+    // Picks the inactive slot and prepares the new extlinux.conf. Logs and
+    // returns false if either is not possible.
+    bool prepare(const Config& config);
+
+    // Whether the target slot can hold `imageSize` bytes
+    bool fits(uint64_t imageSize) const;
+
+    // Partition (or stand-in file) the image is written to
+    const std::string& targetDevice() const { return plan_.targetDev; }
+
+    // Points the boot config at the slot; its content must already be durable
+    bool commit();
+
+   private:
+    Config config_;
+    Plan plan_{};
+    std::string bootconf_;
+};
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+// Bounded lock-free ring between exactly one producer thread and one
+// consumer thread. Neither side blocks: push() fails when the ring is full
+// and pop() fails when it is empty. Each side caches the other's index and
+// only re-reads the shared atomic when the cached value says full/empty.
+template <typename T>
+class SpscQueue {
+   public:
+    // Capacity is rounded up to a power of two
+    explicit SpscQueue(size_t capacity) : mask_(roundUp(capacity) - 1), slots_(new T[mask_ + 1]) {}
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // Producer side
+    bool push(T&& item) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - headCache_ > mask_) {
+            headCache_ = head_.load(std::memory_order_acquire);
+            if (tail - headCache_ > mask_) return false;
+        }
+        slots_[tail & mask_] = std::move(item);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side
+    bool pop(T& item) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tailCache_) {
+            tailCache_ = tail_.load(std::memory_order_acquire);
+            if (head == tailCache_) return false;
+        }
+        item = std::move(slots_[head & mask_]);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool empty() const { return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire); }
+
+    size_t capacity() const { return mask_ + 1; }
+
+   private:
+    static size_t roundUp(size_t n) {
+        size_t c = 2;
+        while (c < n) c <<= 1;
+        return c;
+    }
+
+    const size_t mask_;
+    const std::unique_ptr<T[]> slots_;
+
+    // Producer and consumer indices on separate cache lines
+    char pad0_[64];
+    std::atomic<size_t> head_{0};
+    size_t tailCache_ = 0;  // consumer's last view of tail_
+    char pad1_[64];
+    std::atomic<size_t> tail_{0};
+    size_t headCache_ = 0;  // producer's last view of head_
+    char pad2_[64];
+};
@@ -0,0 +1,87 @@
+#include "StreamVerifier.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+StreamVerifier::StreamVerifier(uint64_t size, Reader reader) : size_(size), reader_(std::move(reader)) {}
+
+void StreamVerifier::onWritten(uint64_t offset, const uint8_t* data, size_t size) {
+    record(offset, data, size, nullptr);
+}
+
+void StreamVerifier::onWritten(uint64_t offset, const uint8_t* data, size_t size, uint32_t crc) {
+    record(offset, data, size, &crc);
+}
+
+void StreamVerifier::record(uint64_t offset, const uint8_t* data, size_t size, const uint32_t* crc) {
+    uint64_t end = std::min<uint64_t>(offset + size, size_);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (end <= hashed_) return;  // already covered
+
+    if (offset > hashed_) {
+        // Ahead of the prefix: merge into the known ranges and wait for the gap
+        auto it = ahead_.upper_bound(offset);
+        if (it != ahead_.begin() && std::prev(it)->second >= offset) {
+            --it;
+            offset = it->first;
+            end = std::max(end, it->second);
+            it = ahead_.erase(it);
+        }
+        while (it != ahead_.end() && it->first <= end) {
+            end = std::max(end, it->second);
+            it = ahead_.erase(it);
+        }
+        ahead_[offset] = end;
+        return;
+    }
+
+    // Extends the prefix, possibly overlapping bytes hashed before; the
+    // piece's own CRC only fits if all of it is new
+    const uint64_t skip = hashed_ - offset;
+    if (skip != 0 || end != offset + size) crc = nullptr;
+    hashLocked(data + skip, static_cast<size_t>(end - hashed_), crc);
+    drainLocked();
+}
+
+StreamVerifier::Result StreamVerifier::finish() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    drainLocked();
+
+    Result r;
+    r.complete = (hashed_ == size_);
+    r.crc = crc_.value();
+    r.sha256 = sha_.hexDigest();
+    r.rereadBytes = rereadBytes_;
+    return r;
+}
+
+void StreamVerifier::hashLocked(const uint8_t* data, size_t size, const uint32_t* crc) {
+    if (crc) crc_.combine(*crc, size);
+    else crc_.update(data, size);
+    sha_.update(data, size);
+    hashed_ += size;
+}
+
+void StreamVerifier::drainLocked() {
+    std::vector<uint8_t> buf;
+
+    while (!ahead_.empty() && ahead_.begin()->first <= hashed_) {
+        const uint64_t end = ahead_.begin()->second;
+        ahead_.erase(ahead_.begin());
+
+        if (buf.empty()) buf.resize(1024 * 1024);
+        while (hashed_ < end) {
+            size_t want = static_cast<size_t>(std::min<uint64_t>(buf.size(), end - hashed_));
+            if (!reader_(hashed_, buf.data(), want)) {
+                std::cerr << std::endl << "[Client] Verification read failed at offset " << hashed_ << std::endl;
+                return;
+            }
+            rereadBytes_ += want;
+            hashLocked(buf.data(), want, nullptr);
+        }
+    }
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include "ota/Checksum.hpp"
+
+// Computes CRC32 and SHA-256 of the image while it is being received, so
+// no second read of a multi-GB file is needed to verify it. Both hashes
+// need the bytes in image order: a write that extends the hashed prefix is
+// hashed straight from the receive buffer; a write further ahead is only
+// remembered, and once the gap before it closes that range is read back
+// from the output, usually while it is still in a coalescing buffer or the
+// page cache.
+class StreamVerifier {
+   public:
+    struct Result {
+        bool complete = false;  // every byte of the image was hashed
+        uint32_t crc = 0;
+        std::string sha256;
+        uint64_t rereadBytes = 0;  // hashed from the file instead of the receive buffer
+    };
+
+    // Reads `size` bytes of written image at `offset`, false on failure
+    typedef std::function<bool(uint64_t offset, uint8_t* data, size_t size)> Reader;
+
+    StreamVerifier(uint64_t size, Reader reader);
+
+    // Reports `size` bytes just written at `offset`. Thread-safe.
+    void onWritten(uint64_t offset, const uint8_t* data, size_t size);
+
+    // Same, with the piece's CRC32 computed elsewhere: when the piece
+    // extends the prefix only SHA-256 runs over it here
+    void onWritten(uint64_t offset, const uint8_t* data, size_t size, uint32_t crc);
+
+    // Finishes both hashes; call once, after the last write
+    Result finish();
+
+   private:
+    void record(uint64_t offset, const uint8_t* data, size_t size, const uint32_t* crc);
+    void hashLocked(const uint8_t* data, size_t size, const uint32_t* crc);
+    void drainLocked();
+
+    uint64_t size_;
+    Reader reader_;
+
+    std::mutex mutex_;
+    uint64_t hashed_ = 0;                 // bytes [0, hashed_) went through both hashes
+    std::map<uint64_t, uint64_t> ahead_;  // written ranges past hashed_, start -> end
+    uint64_t rereadBytes_ = 0;
+    Crc32 crc_;
+    Sha256 sha_;
+};
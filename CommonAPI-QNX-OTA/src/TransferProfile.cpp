@@ -0,0 +1,65 @@
+#include "TransferProfile.hpp"
+
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <sstream>
+
+namespace {
+
+const uint32_t kMinChunkSize = 4 * 1024;
+const uint32_t kMaxChunkSize = 4 * 1024 * 1024;
+
+}  // namespace
+
+TransferProfile TransferProfile::fromConfig(const IniConfig& config) {
+    TransferProfile p;
+
+    p.updateDir = config.get("transfer", "update_dir", p.updateDir);
+    if (!p.updateDir.empty() && p.updateDir.back() != '/') p.updateDir += '/';
+    p.imageName = config.get("transfer", "update_image", p.imageName);
+
+    uint64_t chunkSize = config.getUint("transfer", "chunk_size", p.chunkSize);
+    p.chunkSize = static_cast<uint32_t>(std::max<uint64_t>(kMinChunkSize, std::min<uint64_t>(chunkSize, kMaxChunkSize)));
+    p.rateLimit = config.getUint("transfer", "rate_limit", p.rateLimit);
+    p.maxSessions = static_cast<uint32_t>(std::max<uint64_t>(1, config.getUint("transfer", "max_sessions", p.maxSessions)));
+    p.maxStripes = static_cast<uint32_t>(config.getUint("transfer", "max_stripes", p.maxStripes));
+
+    Pacer::Config& pc = p.pacing;
+    pc.initialWindow = static_cast<uint32_t>(config.getUint("transfer", "window", pc.initialWindow));
+    pc.minWindow = static_cast<uint32_t>(std::max<uint64_t>(1, config.getUint("transfer", "window_min", pc.minWindow)));
+    pc.maxWindow = static_cast<uint32_t>(std::max<uint64_t>(pc.minWindow, config.getUint("transfer", "window_max", pc.maxWindow)));
+    pc.initialWindow = std::max(pc.minWindow, std::min(pc.initialWindow, pc.maxWindow));
+    pc.stallMs = static_cast<unsigned>(config.getUint("transfer", "stall_ms", pc.stallMs));
+    pc.slowSendMs = static_cast<unsigned>(config.getUint("transfer", "slow_send_ms", pc.slowSendMs));
+    p.expireStalls = static_cast<uint32_t>(config.getUint("transfer", "session_expire_stalls", p.expireStalls));
+
+    p.cacheBudget = config.getUint("transfer", "cache_budget", p.cacheBudget);
+    p.ioBackend = config.get("transfer", "io_backend", p.ioBackend);
+    p.ioQueueDepth = static_cast<unsigned>(std::max<uint64_t>(1, config.getUint("transfer", "io_queue_depth", p.ioQueueDepth)));
+
+    return p;
+}
+
+std::string TransferProfile::describe() const {
+    std::ostringstream os;
+    os << "image=" << imagePath() << " chunk=" << (chunkSize / 1024) << "KB rate=" << (rateLimit ? std::to_string(rateLimit) + "B/s" : "unlimited")
+       << " sessions=" << maxSessions << " stripes=" << maxStripes << " window=" << pacing.minWindow << "/" << pacing.initialWindow << "/"
+       << pacing.maxWindow << " cache=" << (cacheBudget / (1024 * 1024)) << "MB io=" << ioBackend << " depth " << ioQueueDepth;
+    return os.str();
+}
+
+ProfileWatcher::ProfileWatcher(const std::string& path) : path_(path) { changed(); }
+
+bool ProfileWatcher::changed() {
+    struct stat st;
+    if (stat(path_.c_str(), &st) != 0) return false;
+
+    int64_t mtime = static_cast<int64_t>(st.st_mtime);
+    int64_t size = static_cast<int64_t>(st.st_size);
+    if (mtime == mtime_ && size == size_) return false;
+
+    mtime_ = mtime;
+    size_ = size;
+    return true;
+}
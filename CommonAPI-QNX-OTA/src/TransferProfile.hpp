@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "IniConfig.hpp"
+#include "Pacer.hpp"
+
+// Per-deployment tuning of the server, read from the [transfer] section so a
+// QNX gateway can be retuned without a rebuild. The image location is read
+// once at startup; everything else is re-applied on hot reload (chunk size,
+// I/O backend and pacing take effect for sessions started afterwards).
+struct TransferProfile {
+    std::string updateDir = "data/server/";
+    std::string imageName = "rootfs.ext4";
+
+    uint32_t chunkSize = 64 * 1024;
+    uint64_t rateLimit = 0;    // bytes/s per event-path session, 0 = unlimited
+    uint32_t maxSessions = 8;  // concurrent event-path sender threads
+    uint32_t maxStripes = 4;   // data plane connections per session
+    Pacer::Config pacing;
+    uint32_t expireStalls = 30;  // stall periods without any ack before an event-path session is dropped, 0 = never
+
+    uint64_t cacheBudget = 64 * 1024 * 1024;
+    std::string ioBackend = "auto";
+    unsigned ioQueueDepth = 8;
+
+    std::string imagePath() const { return updateDir + imageName; }
+
+    static TransferProfile fromConfig(const IniConfig& config);
+
+    // Single-line summary for the startup and reload logs
+    std::string describe() const;
+};
+
+// Detects edits of the profile file by polling its modification time
+class ProfileWatcher {
+   public:
+    explicit ProfileWatcher(const std::string& path);
+
+    // True once per change since the previous call
+    bool changed();
+
+   private:
+    std::string path_;
+    int64_t mtime_ = 0;
+    int64_t size_ = 0;
+};
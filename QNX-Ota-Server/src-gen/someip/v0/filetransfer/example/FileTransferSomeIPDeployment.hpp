@@ -1,53 +0,0 @@
-/*
- * This file was generated by the CommonAPI Generators.
- * Used org.genivi.commonapi.someip 3.2.15.v202410041637.
- * Used org.franca.core 0.13.1.201807231814.
- *
- * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
- * If a copy of the MPL was not distributed with this file, You can obtain one at
- * http://mozilla.org/MPL/2.0/.
- */
-
-#ifndef V0_FILETRANSFER_EXAMPLE_File_Transfer_SOMEIP_DEPLOYMENT_HPP_
-#define V0_FILETRANSFER_EXAMPLE_File_Transfer_SOMEIP_DEPLOYMENT_HPP_
-
-
-#if !defined (COMMONAPI_INTERNAL_COMPILATION)
-#define COMMONAPI_INTERNAL_COMPILATION
-#define HAS_DEFINED_COMMONAPI_INTERNAL_COMPILATION_HERE
-#endif
-#include <CommonAPI/SomeIP/Deployment.hpp>
-#if defined (HAS_DEFINED_COMMONAPI_INTERNAL_COMPILATION_HERE)
-#undef COMMONAPI_INTERNAL_COMPILATION
-#undef HAS_DEFINED_COMMONAPI_INTERNAL_COMPILATION_HERE
-#endif
-
-namespace v0 {
-namespace filetransfer {
-namespace example {
-namespace FileTransfer_ {
-
-// Interface-specific deployment types
-typedef CommonAPI::SomeIP::StructDeployment<
-    CommonAPI::EmptyDeployment,
-    CommonAPI::EmptyDeployment,
-    CommonAPI::SomeIP::IntegerDeployment<uint32_t>,
-    CommonAPI::SomeIP::IntegerDeployment<uint64_t>,
-    CommonAPI::SomeIP::IntegerDeployment<uint32_t>,
-    CommonAPI::SomeIP::IntegerDeployment<int32_t>
-> UpdateInfoDeployment_t;
-
-// Type-specific deployments
-
-// Attribute-specific deployments
-
-// Argument-specific deployment
-
-// Broadcast-specific deployments
-
-} // namespace FileTransfer_
-} // namespace example
-} // namespace filetransfer
-} // namespace v0
-
-#endif // V0_FILETRANSFER_EXAMPLE_File_Transfer_SOMEIP_DEPLOYMENT_HPP_
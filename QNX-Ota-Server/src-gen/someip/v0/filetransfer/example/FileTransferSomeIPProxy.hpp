@@ -1,82 +0,0 @@
-/*
- * This file was generated by the CommonAPI Generators.
- * Used org.genivi.commonapi.someip 3.2.15.v202410041637.
- * Used org.franca.core 0.13.1.201807231814.
- *
- * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
- * If a copy of the MPL was not distributed with this file, You can obtain one at
- * http://mozilla.org/MPL/2.0/.
- */
-#ifndef V0_FILETRANSFER_EXAMPLE_FILE_TRANSFER_SOMEIP_PROXY_HPP_
-#define V0_FILETRANSFER_EXAMPLE_FILE_TRANSFER_SOMEIP_PROXY_HPP_
-
-#include <v0/filetransfer/example/FileTransferProxyBase.hpp>
-#include <v0/filetransfer/example/FileTransferSomeIPDeployment.hpp>
-
-#if !defined (COMMONAPI_INTERNAL_COMPILATION)
-#define COMMONAPI_INTERNAL_COMPILATION
-#define HAS_DEFINED_COMMONAPI_INTERNAL_COMPILATION_HERE
-#endif
-
-#include <CommonAPI/SomeIP/Factory.hpp>
-#include <CommonAPI/SomeIP/Proxy.hpp>
-#include <CommonAPI/SomeIP/Types.hpp>
-#include <CommonAPI/SomeIP/Event.hpp>
-
-#if defined (HAS_DEFINED_COMMONAPI_INTERNAL_COMPILATION_HERE)
-#undef COMMONAPI_INTERNAL_COMPILATION
-#undef HAS_DEFINED_COMMONAPI_INTERNAL_COMPILATION_HERE
-#endif
-
-#include <string>
-
-# if defined(_MSC_VER)
-#  if _MSC_VER >= 1300
-/*
- * Diamond inheritance is used for the CommonAPI::Proxy base class.
- * The Microsoft compiler put warning (C4250) using a desired c++ feature: "Delegating to a sister class"
- * A powerful technique that arises from using virtual inheritance is to delegate a method from a class in another class
- * by using a common abstract base class. This is also called cross delegation.
- */
-#    pragma warning( disable : 4250 )
-#  endif
-# endif
-
-namespace v0 {
-namespace filetransfer {
-namespace example {
-
-class FileTransferSomeIPProxy
-    : virtual public FileTransferProxyBase,
-      virtual public CommonAPI::SomeIP::Proxy {
-public:
-    FileTransferSomeIPProxy(
-        const CommonAPI::SomeIP::Address &_address,
-        const std::shared_ptr<CommonAPI::SomeIP::ProxyConnection> &_connection);
-
-    virtual ~FileTransferSomeIPProxy();
-
-    virtual FileChunkEvent& getFileChunkEvent();
-
-    virtual void requestUpdate(uint32_t _currentVersion, CommonAPI::CallStatus &_internalCallStatus, FileTransfer::UpdateInfo &_info_, const CommonAPI::CallInfo *_info);
-
-    virtual std::future<CommonAPI::CallStatus> requestUpdateAsync(const uint32_t &_currentVersion, RequestUpdateAsyncCallback _callback, const CommonAPI::CallInfo *_info);
-
-    virtual void startTransfer(std::string _fileName, CommonAPI::CallStatus &_internalCallStatus, bool &_accepted, const CommonAPI::CallInfo *_info);
-
-    virtual std::future<CommonAPI::CallStatus> startTransferAsync(const std::string &_fileName, StartTransferAsyncCallback _callback, const CommonAPI::CallInfo *_info);
-
-    virtual void getOwnVersion(uint16_t &_major, uint16_t &_minor) const;
-
-    virtual std::future<void> getCompletionFuture();
-
-private:
-    CommonAPI::SomeIP::Event<FileChunkEvent, CommonAPI::Deployable< uint32_t, CommonAPI::SomeIP::IntegerDeployment<uint32_t> >, CommonAPI::Deployable< CommonAPI::ByteBuffer, CommonAPI::SomeIP::ByteBufferDeployment >, CommonAPI::Deployable< bool, CommonAPI::EmptyDeployment >> fileChunk_;
-
-};
-
-} // namespace example
-} // namespace filetransfer
-} // namespace v0
-
-#endif // V0_FILETRANSFER_EXAMPLE_File_Transfer_SOMEIP_PROXY_HPP_
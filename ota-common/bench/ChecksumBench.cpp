@@ -0,0 +1,89 @@
+// Cross-checks every checksum kernel the CPU supports against the portable
+// one, then reports the throughput of each.
+//
+//   checksum-bench [megabytes]   (default 256)
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "ota/Checksum.hpp"
+
+namespace {
+
+// Lengths around the kernels' block and fold sizes, plus unaligned starts
+const size_t kCheckLengths[] = {0, 1, 3, 15, 16, 17, 55, 56, 63, 64, 65, 127, 128, 129, 1000, 4096, 65537};
+
+template <typename Fn>
+double megabytesPerSecond(size_t bytes, Fn&& run) {
+    auto start = std::chrono::steady_clock::now();
+    run();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() > 0 ? (bytes / (1024.0 * 1024.0)) / elapsed.count() : 0.0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    size_t megabytes = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 256;
+    if (megabytes == 0) megabytes = 1;
+
+    std::vector<uint8_t> data(megabytes * 1024 * 1024);
+    std::mt19937_64 rng(0x0DA7A);
+    for (auto& b : data) b = static_cast<uint8_t>(rng());
+
+    const Crc32Kernel& crcRef = Crc32::kernels().back();
+    const Sha256Kernel& shaRef = Sha256::kernels().back();
+    bool ok = true;
+
+    for (const Crc32Kernel& k : Crc32::kernels()) {
+        if (!k.available()) {
+            std::cout << "crc32  " << std::setw(12) << std::left << k.name << "not supported" << std::endl;
+            continue;
+        }
+        for (size_t len : kCheckLengths) {
+            for (size_t start = 0; start < 4; ++start) {
+                Crc32 a(k), b(crcRef);
+                a.update(data.data() + start, len);
+                b.update(data.data() + start, len);
+                if (a.value() != b.value()) {
+                    std::cerr << "crc32 " << k.name << " mismatch at length " << len << std::endl;
+                    ok = false;
+                }
+            }
+        }
+
+        Crc32 crc(k);
+        double rate = megabytesPerSecond(data.size(), [&] { crc.update(data.data(), data.size()); });
+        std::cout << "crc32  " << std::setw(12) << std::left << k.name << std::fixed << std::setprecision(0) << rate << " MB/s"
+                  << (&k == &Crc32::best() ? "  (selected)" : "") << std::endl;
+    }
+
+    for (const Sha256Kernel& k : Sha256::kernels()) {
+        if (!k.available()) {
+            std::cout << "sha256 " << std::setw(12) << std::left << k.name << "not supported" << std::endl;
+            continue;
+        }
+        for (size_t len : kCheckLengths) {
+            for (size_t start = 0; start < 4; ++start) {
+                Sha256 a(k), b(shaRef);
+                a.update(data.data() + start, len);
+                b.update(data.data() + start, len);
+                if (a.hexDigest() != b.hexDigest()) {
+                    std::cerr << "sha256 " << k.name << " mismatch at length " << len << std::endl;
+                    ok = false;
+                }
+            }
+        }
+
+        Sha256 sha(k);
+        double rate = megabytesPerSecond(data.size(), [&] { sha.update(data.data(), data.size()); });
+        std::cout << "sha256 " << std::setw(12) << std::left << k.name << std::fixed << std::setprecision(0) << rate << " MB/s"
+                  << (&k == &Sha256::best() ? "  (selected)" : "") << std::endl;
+    }
+
+    return ok ? 0 : 1;
+}
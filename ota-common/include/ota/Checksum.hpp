@@ -0,0 +1,79 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Checksums shared by the gateway, the client and ota-apply. Each hash has
+// several kernels compiled in (PCLMULQDQ / SHA-NI on x86, the ARMv8 CRC32
+// and SHA2 instructions on aarch64, and a portable one); the fastest the
+// CPU supports is picked at runtime.
+
+struct Crc32Kernel {
+    const char* name;
+    bool (*available)();
+    // Advances the raw (inverted) CRC register over `size` bytes
+    uint32_t (*update)(uint32_t state, const uint8_t* data, size_t size);
+};
+
+struct Sha256Kernel {
+    const char* name;
+    bool (*available)();
+    // Runs the compression function over `blocks` consecutive 64-byte blocks
+    void (*compress)(uint32_t state[8], const uint8_t* data, size_t blocks);
+};
+
+// CRC-32 (IEEE 802.3, as produced by zlib's crc32() and `crc32` tools),
+// computed incrementally over any number of update() calls.
+class Crc32 {
+   public:
+    Crc32();
+    explicit Crc32(const Crc32Kernel& kernel);
+
+    void update(const uint8_t* data, size_t size) { state_ = kernel_->update(state_, data, size); }
+    uint32_t value() const { return ~state_; }
+
+    // Appends a block of `size` bytes whose own CRC-32 is `crc`, as if the
+    // block had gone through update(). Lets blocks be checksummed on other
+    // threads and chained here in O(log size).
+    void combine(uint32_t crc, uint64_t size);
+
+    const char* kernelName() const { return kernel_->name; }
+
+    // Every kernel built into this binary, fastest first; the last one is portable
+    static const std::vector<Crc32Kernel>& kernels();
+    static const Crc32Kernel& best();
+
+   private:
+    const Crc32Kernel* kernel_;
+    uint32_t state_ = 0xFFFFFFFFu;
+};
+
+// SHA-256 (FIPS 180-4), computed incrementally
+class Sha256 {
+   public:
+    Sha256();
+    explicit Sha256(const Sha256Kernel& kernel);
+
+    void update(const uint8_t* data, size_t size);
+
+    // Finishes the hash; further update() calls are not allowed
+    std::array<uint8_t, 32> digest();
+
+    // Lower-case hex digest, the format of sha256sum
+    std::string hexDigest();
+
+    const char* kernelName() const { return kernel_->name; }
+
+    static const std::vector<Sha256Kernel>& kernels();
+    static const Sha256Kernel& best();
+
+   private:
+    const Sha256Kernel* kernel_;
+    uint32_t state_[8];
+    uint8_t buffer_[64];
+    size_t buffered_ = 0;
+    uint64_t length_ = 0;
+};
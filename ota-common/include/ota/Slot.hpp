@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+// A/B slot logic shared by ota-apply and the client's direct-to-slot mode.
+// Functions report failures by throwing std::runtime_error.
+
+enum class Slot { A, B };
+
+// Block devices and partition labels of the two root filesystem slots
+struct SlotLayout {
+    std::string devA;
+    std::string devB;
+    std::string labelA = "rootfsA";
+    std::string labelB = "rootfsB";
+
+    // Raspberry Pi (mmcblk0p2/p3) or QEMU (vda2/vda3) naming, chosen by QEMU_ENV at build time
+    static SlotLayout defaults();
+};
+
+struct Plan {
+    Slot active;
+    Slot target;
+    std::string targetDev;    // /dev/mmcblk0p2 or p3
+    std::string targetLabel;  // rootfsA or rootfsB
+};
+
+std::string readTextFile(const std::string& path);
+
+// Active slot from the kernel command line; false if it names neither slot
+bool detectActiveSlotFromCmdline(const std::string& cmdline, Slot& active);
+
+Plan buildPlan(Slot active, const SlotLayout& layout = SlotLayout::defaults());
+
+// Size of the target partition. A regular file is accepted too, so a file
+// or loop device can stand in for the partition in tests.
+uint64_t blockDeviceSizeBytes(const std::string& devPath);
+
+// Writes `content` to a temp file, fsyncs it and renames it over `path`
+void atomicWriteFile(const std::string& path, const std::string& content);
+
+// extlinux.conf with root=PARTLABEL=rootfsA/B pointing at `newLabel`
+std::string updateExtlinuxRootPartlabel(const std::string& extlinux, const std::string& newLabel);
@@ -0,0 +1,255 @@
+#include "ota/Checksum.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "ChecksumKernels.hpp"
+
+namespace {
+
+struct CrcTables {
+    uint32_t t[8][256];
+
+    CrcTables() {
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k) c = (c & 1) ? (c >> 1) ^ 0xEDB88320u : c >> 1;
+            t[0][i] = c;
+        }
+        for (uint32_t i = 0; i < 256; ++i) {
+            for (int k = 1; k < 8; ++k) t[k][i] = (t[k - 1][i] >> 8) ^ t[0][t[k - 1][i] & 0xFF];
+        }
+    }
+};
+
+const CrcTables& crcTables() {
+    static const CrcTables tables;
+    return tables;
+}
+
+// a(x) * b(x) modulo the CRC polynomial, both in reflected bit order
+uint32_t multModP(uint32_t a, uint32_t b) {
+    uint32_t m = 1u << 31;
+    uint32_t p = 0;
+    for (;;) {
+        if (a & m) {
+            p ^= b;
+            if ((a & (m - 1)) == 0) break;
+        }
+        m >>= 1;
+        b = (b & 1) ? (b >> 1) ^ 0xEDB88320u : b >> 1;
+    }
+    return p;
+}
+
+// x^(2^k) modulo the CRC polynomial for k = 0..31
+struct CrcPowers {
+    uint32_t x2n[32];
+
+    CrcPowers() {
+        uint32_t p = 1u << 30;  // x^1
+        x2n[0] = p;
+        for (int k = 1; k < 32; ++k) x2n[k] = p = multModP(p, p);
+    }
+};
+
+// x^(n * 2^k) modulo the CRC polynomial
+uint32_t xPowModP(uint64_t n, unsigned k) {
+    static const CrcPowers powers;
+    uint32_t p = 1u << 31;  // x^0
+    for (; n != 0; n >>= 1, ++k) {
+        if (n & 1) p = multModP(powers.x2n[k & 31], p);
+    }
+    return p;
+}
+
+inline uint32_t rotr(uint32_t x, int n) { return (x >> n) | (x << (32 - n)); }
+
+bool always() { return true; }
+
+}  // namespace
+
+const uint32_t kSha256RoundConstants[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be,
+    0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa,
+    0x5cb0a9dc, 0x76f988da, 0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967, 0x27b70a85,
+    0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
+    0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070, 0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f,
+    0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+uint32_t crc32Portable(uint32_t state, const uint8_t* data, size_t size) {
+    const CrcTables& tab = crcTables();
+    uint32_t c = state;
+
+    // Slicing-by-8: one table lookup per byte, eight bytes per step
+    while (size >= 8) {
+        uint32_t lo = c ^ (static_cast<uint32_t>(data[0]) | static_cast<uint32_t>(data[1]) << 8 | static_cast<uint32_t>(data[2]) << 16 |
+                           static_cast<uint32_t>(data[3]) << 24);
+        c = tab.t[7][lo & 0xFF] ^ tab.t[6][(lo >> 8) & 0xFF] ^ tab.t[5][(lo >> 16) & 0xFF] ^ tab.t[4][lo >> 24] ^ tab.t[3][data[4]] ^
+            tab.t[2][data[5]] ^ tab.t[1][data[6]] ^ tab.t[0][data[7]];
+        data += 8;
+        size -= 8;
+    }
+    while (size-- > 0) c = (c >> 8) ^ tab.t[0][(c ^ *data++) & 0xFF];
+
+    return c;
+}
+
+void sha256Portable(uint32_t state[8], const uint8_t* data, size_t blocks) {
+    for (; blocks > 0; --blocks, data += 64) {
+        uint32_t w[64];
+        for (int i = 0; i < 16; ++i) {
+            w[i] = static_cast<uint32_t>(data[4 * i]) << 24 | static_cast<uint32_t>(data[4 * i + 1]) << 16 |
+                   static_cast<uint32_t>(data[4 * i + 2]) << 8 | static_cast<uint32_t>(data[4 * i + 3]);
+        }
+        for (int i = 16; i < 64; ++i) {
+            uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+
+        uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+        uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+
+        for (int i = 0; i < 64; ++i) {
+            uint32_t t1 = h + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) + ((e & f) ^ (~e & g)) + kSha256RoundConstants[i] + w[i];
+            uint32_t t2 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
+
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        state[5] += f;
+        state[6] += g;
+        state[7] += h;
+    }
+}
+
+const std::vector<Crc32Kernel>& Crc32::kernels() {
+    static const std::vector<Crc32Kernel> list = {
+#if defined(__x86_64__) || defined(__i386__)
+        {"pclmul", crc32PclmulAvailable, crc32Pclmul},
+#endif
+#if defined(__aarch64__)
+        {"armv8-crc", crc32Armv8Available, crc32Armv8},
+#endif
+        {"portable", always, crc32Portable},
+    };
+    return list;
+}
+
+const Crc32Kernel& Crc32::best() {
+    static const Crc32Kernel* kernel = [] {
+        for (const Crc32Kernel& k : kernels()) {
+            if (k.available()) return &k;
+        }
+        return &kernels().back();
+    }();
+    return *kernel;
+}
+
+Crc32::Crc32() : kernel_(&best()) {}
+
+Crc32::Crc32(const Crc32Kernel& kernel) : kernel_(&kernel) {}
+
+void Crc32::combine(uint32_t crc, uint64_t size) {
+    // Shifting the running CRC over `size` zero bytes (x^(8 * size)) and
+    // adding the block's CRC gives the CRC of the concatenation
+    state_ = ~(multModP(xPowModP(size, 3), ~state_) ^ crc);
+}
+
+const std::vector<Sha256Kernel>& Sha256::kernels() {
+    static const std::vector<Sha256Kernel> list = {
+#if defined(__x86_64__) || defined(__i386__)
+        {"sha-ni", sha256ShaNiAvailable, sha256ShaNi},
+#endif
+#if defined(__aarch64__)
+        {"armv8-sha2", sha256Armv8Available, sha256Armv8},
+#endif
+        {"portable", always, sha256Portable},
+    };
+    return list;
+}
+
+const Sha256Kernel& Sha256::best() {
+    static const Sha256Kernel* kernel = [] {
+        for (const Sha256Kernel& k : kernels()) {
+            if (k.available()) return &k;
+        }
+        return &kernels().back();
+    }();
+    return *kernel;
+}
+
+Sha256::Sha256() : Sha256(best()) {}
+
+Sha256::Sha256(const Sha256Kernel& kernel) : kernel_(&kernel) {
+    static const uint32_t kInit[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+    std::memcpy(state_, kInit, sizeof(state_));
+}
+
+void Sha256::update(const uint8_t* data, size_t size) {
+    if (size == 0) return;
+    length_ += size;
+
+    if (buffered_ > 0) {
+        size_t take = std::min(size, sizeof(buffer_) - buffered_);
+        std::memcpy(buffer_ + buffered_, data, take);
+        buffered_ += take;
+        data += take;
+        size -= take;
+        if (buffered_ < sizeof(buffer_)) return;
+        kernel_->compress(state_, buffer_, 1);
+        buffered_ = 0;
+    }
+
+    if (size >= 64) {
+        kernel_->compress(state_, data, size / 64);
+        data += size & ~static_cast<size_t>(63);
+        size &= 63;
+    }
+
+    std::memcpy(buffer_, data, size);
+    buffered_ = size;
+}
+
+std::array<uint8_t, 32> Sha256::digest() {
+    const uint64_t bits = length_ * 8;
+
+    uint8_t pad[72] = {0x80};
+    size_t padLen = (buffered_ < 56) ? 56 - buffered_ : 120 - buffered_;
+    for (int i = 0; i < 8; ++i) pad[padLen + i] = static_cast<uint8_t>(bits >> (56 - 8 * i));
+    update(pad, padLen + 8);
+
+    std::array<uint8_t, 32> out;
+    for (int i = 0; i < 8; ++i) {
+        out[4 * i] = static_cast<uint8_t>(state_[i] >> 24);
+        out[4 * i + 1] = static_cast<uint8_t>(state_[i] >> 16);
+        out[4 * i + 2] = static_cast<uint8_t>(state_[i] >> 8);
+        out[4 * i + 3] = static_cast<uint8_t>(state_[i]);
+    }
+    return out;
+}
+
+std::string Sha256::hexDigest() {
+    static const char kHex[] = "0123456789abcdef";
+    std::array<uint8_t, 32> d = digest();
+
+    std::string hex;
+    hex.reserve(64);
+    for (uint8_t b : d) {
+        hex.push_back(kHex[b >> 4]);
+        hex.push_back(kHex[b & 0xF]);
+    }
+    return hex;
+}
@@ -0,0 +1,74 @@
+// Built with -march=armv8-a+crc+crypto; only entered after the HWCAP checks below
+#if defined(__aarch64__)
+
+#include <arm_acle.h>
+#include <arm_neon.h>
+#include <cstring>
+
+#if defined(__linux__)
+#include <asm/hwcap.h>
+#include <sys/auxv.h>
+#endif
+
+#include "ChecksumKernels.hpp"
+
+bool crc32Armv8Available() {
+#if defined(__linux__)
+    return (getauxval(AT_HWCAP) & HWCAP_CRC32) != 0;
+#else
+    return false;
+#endif
+}
+
+uint32_t crc32Armv8(uint32_t state, const uint8_t* data, size_t size) {
+    while (size >= 8) {
+        uint64_t word;
+        std::memcpy(&word, data, sizeof(word));
+        state = __crc32d(state, word);
+        data += 8;
+        size -= 8;
+    }
+    while (size-- > 0) state = __crc32b(state, *data++);
+    return state;
+}
+
+bool sha256Armv8Available() {
+#if defined(__linux__)
+    return (getauxval(AT_HWCAP) & HWCAP_SHA2) != 0;
+#else
+    return false;
+#endif
+}
+
+// Four rounds per vsha256h/h2 pair; vsha256su0/su1 extend the schedule
+void sha256Armv8(uint32_t state[8], const uint8_t* data, size_t blocks) {
+    uint32x4_t s0 = vld1q_u32(&state[0]);
+    uint32x4_t s1 = vld1q_u32(&state[4]);
+
+    for (; blocks > 0; --blocks, data += 64) {
+        const uint32x4_t s0Save = s0;
+        const uint32x4_t s1Save = s1;
+        uint32x4_t m[4];
+        for (int i = 0; i < 4; ++i) m[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + 16 * i)));
+
+#pragma GCC unroll 16
+        for (int g = 0; g < 16; ++g) {
+            const uint32x4_t w = vaddq_u32(m[g & 3], vld1q_u32(&kSha256RoundConstants[4 * g]));
+            if (g < 12) {
+                m[g & 3] = vsha256su1q_u32(vsha256su0q_u32(m[g & 3], m[(g + 1) & 3]), m[(g + 2) & 3],
+                                           m[(g + 3) & 3]);
+            }
+            const uint32x4_t tmp = s0;
+            s0 = vsha256hq_u32(s0, s1, w);
+            s1 = vsha256h2q_u32(s1, tmp, w);
+        }
+
+        s0 = vaddq_u32(s0, s0Save);
+        s1 = vaddq_u32(s1, s1Save);
+    }
+
+    vst1q_u32(&state[0], s0);
+    vst1q_u32(&state[4], s1);
+}
+
+#endif
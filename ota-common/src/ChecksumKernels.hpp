@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Kernels behind Crc32 / Sha256. Each architecture file is built with the
+// instruction set extensions it needs and must only be called once its
+// *Available() check passed.
+
+uint32_t crc32Portable(uint32_t state, const uint8_t* data, size_t size);
+void sha256Portable(uint32_t state[8], const uint8_t* data, size_t blocks);
+
+extern const uint32_t kSha256RoundConstants[64];
+
+#if defined(__x86_64__) || defined(__i386__)
+bool crc32PclmulAvailable();
+uint32_t crc32Pclmul(uint32_t state, const uint8_t* data, size_t size);
+
+bool sha256ShaNiAvailable();
+void sha256ShaNi(uint32_t state[8], const uint8_t* data, size_t blocks);
+#endif
+
+#if defined(__aarch64__)
+bool crc32Armv8Available();
+uint32_t crc32Armv8(uint32_t state, const uint8_t* data, size_t size);
+
+bool sha256Armv8Available();
+void sha256Armv8(uint32_t state[8], const uint8_t* data, size_t blocks);
+#endif
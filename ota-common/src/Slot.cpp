@@ -0,0 +1,175 @@
+#include "ota/Slot.hpp"
+
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#if defined(__linux__)
+#include <linux/fs.h>  // BLKGETSIZE64
+#endif
+
+#ifndef QEMU_ENV
+#define QEMU_ENV 1
+#endif
+
+SlotLayout SlotLayout::defaults() {
+    SlotLayout l;
+#if QEMU_ENV == 0
+    l.devA = "/dev/mmcblk0p2";
+    l.devB = "/dev/mmcblk0p3";
+#else
+    l.devA = "/dev/vda2";
+    l.devB = "/dev/vda3";
+#endif
+    return l;
+}
+
+std::string readTextFile(const std::string& path) {
+    std::ifstream f(path);
+    if (!f.is_open()) {
+        throw std::runtime_error("Failed to open " + path + ": " + std::strerror(errno));
+    }
+    std::ostringstream ss;
+    ss << f.rdbuf();
+    return ss.str();
+}
+
+bool detectActiveSlotFromCmdline(const std::string& cmdline, Slot& active) {
+    // Expected patterns:
+    // root=PARTLABEL=rootfsA
+    // root=PARTLABEL=rootfsB
+    if (cmdline.find("root=PARTLABEL=rootfsA") != std::string::npos) {
+        active = Slot::A;
+        return true;
+    }
+    if (cmdline.find("root=PARTLABEL=rootfsB") != std::string::npos) {
+        active = Slot::B;
+        return true;
+    }
+
+    // QEMU / virtio fallback
+    if (cmdline.find("root=/dev/vda2") != std::string::npos) {
+        active = Slot::A;
+        return true;
+    }
+    if (cmdline.find("root=/dev/vda3") != std::string::npos) {
+        active = Slot::B;
+        return true;
+    }
+    return false;
+}
+
+Plan buildPlan(Slot active, const SlotLayout& layout) {
+    Plan p{};
+    p.active = active;
+    p.target = (active == Slot::A) ? Slot::B : Slot::A;
+
+    if (p.target == Slot::A) {
+        p.targetDev = layout.devA;
+        p.targetLabel = layout.labelA;
+    } else {
+        p.targetDev = layout.devB;
+        p.targetLabel = layout.labelB;
+    }
+    return p;
+}
+
+uint64_t blockDeviceSizeBytes(const std::string& devPath) {
+    struct stat st{};
+    if (stat(devPath.c_str(), &st) != 0) {
+        throw std::runtime_error("stat(" + devPath + ") failed: " + std::strerror(errno));
+    }
+    if (S_ISREG(st.st_mode)) return static_cast<uint64_t>(st.st_size);
+
+    int fd = open(devPath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open block device " + devPath + ": " + std::strerror(errno));
+    }
+    uint64_t bytes = 0;
+#if defined(BLKGETSIZE64)
+    if (ioctl(fd, BLKGETSIZE64, &bytes) != 0) {
+        close(fd);
+        throw std::runtime_error("ioctl(BLKGETSIZE64) failed for " + devPath + ": " + std::strerror(errno));
+    }
+#else
+    off_t end = lseek(fd, 0, SEEK_END);
+    if (end < 0) {
+        close(fd);
+        throw std::runtime_error("Cannot size " + devPath + ": " + std::strerror(errno));
+    }
+    bytes = static_cast<uint64_t>(end);
+#endif
+    close(fd);
+    return bytes;
+}
+
+void atomicWriteFile(const std::string& path, const std::string& content) {
+    // Write to temp file in same directory then rename()
+    std::string tmp = path + ".tmp";
+    int fd = open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open temp file " + tmp + ": " + std::strerror(errno));
+    }
+
+    ssize_t total = 0;
+    const char* buf = content.data();
+    ssize_t len = static_cast<ssize_t>(content.size());
+    while (total < len) {
+        ssize_t n = write(fd, buf + total, len - total);
+        if (n < 0) {
+            close(fd);
+            throw std::runtime_error("Write failed to " + tmp + ": " + std::strerror(errno));
+        }
+        total += n;
+    }
+
+    if (fsync(fd) != 0) {
+        close(fd);
+        throw std::runtime_error("fsync failed for " + tmp + ": " + std::strerror(errno));
+    }
+    close(fd);
+
+    if (rename(tmp.c_str(), path.c_str()) != 0) {
+        throw std::runtime_error("rename(" + tmp + " -> " + path + ") failed: " + std::strerror(errno));
+    }
+
+    // Best effort to fsync directory entry
+    auto slash = path.find_last_of('/');
+    if (slash != std::string::npos) {
+        std::string dir = path.substr(0, slash);
+        int dfd = open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (dfd >= 0) {
+            fsync(dfd);
+            close(dfd);
+        }
+    }
+}
+
+std::string updateExtlinuxRootPartlabel(const std::string& extlinux, const std::string& newLabel) {
+    // Replace only "root=PARTLABEL=rootfsA" or "root=PARTLABEL=rootfsB"
+    // Keep everything else the same.
+    std::string out = extlinux;
+
+    const std::string a = "root=PARTLABEL=rootfsA";
+    const std::string b = "root=PARTLABEL=rootfsB";
+    size_t posA = out.find(a);
+    size_t posB = out.find(b);
+
+    if (posA == std::string::npos && posB == std::string::npos) {
+        throw std::runtime_error("extlinux.conf does not contain root=PARTLABEL=rootfsA/B");
+    }
+
+    const std::string repl = "root=PARTLABEL=" + newLabel;
+
+    if (posA != std::string::npos) out.replace(posA, a.size(), repl);
+    if (posB != std::string::npos) out.replace(posB, b.size(), repl);
+    return out;
+}
@@ -1,90 +1,46 @@
+#include <algorithm>
 #include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <condition_variable>
 #include <cstring>
+#include <deque>
+#include <exception>
 #include <fcntl.h>
-#include <fstream>
 #include <iostream>
-#include <optional>
-#include <sstream>
+#include <memory>
+#include <new>
 #include <stdexcept>
+#include <mutex>
 #include <string>
 #include <sys/ioctl.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <thread>
 #include <unistd.h>
+#include <vector>
 
-#include <linux/fs.h> // BLKGETSIZE64
 #include <cstdint>
 
-#define QEMU_ENV 1
-
-namespace {
-
-enum class Slot { A, B };
-
-struct Plan {
-    Slot active;
-    Slot target;
-    std::string targetDev;   // /dev/mmcblk0p2 or p3
-    std::string targetLabel; // rootfsA or rootfsB
-};
-
+#if defined(__linux__)
+#include <linux/fs.h>  // BLKDISCARD, BLKZEROOUT
+#endif
 
-#if QEMU_ENV == 0
-static const char* kDevA = "/dev/mmcblk0p2";
-static const char* kDevB = "/dev/mmcblk0p3";
-static const char* kLabelA = "rootfsA";
-static const char* kLabelB = "rootfsB";
-#else
-static const char* kDevA = "/dev/vda2";
-static const char* kDevB = "/dev/vda3";
-static const char* kLabelA = "rootfsA";
-static const char* kLabelB = "rootfsB";
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
 #endif
 
+#include "ota/Checksum.hpp"
+#include "ota/Slot.hpp"
 
-std::string readTextFile(const std::string& path) {
-    std::ifstream f(path);
-    if (!f.is_open()) {
-        throw std::runtime_error("Failed to open " + path + ": " + std::strerror(errno));
-    }
-    std::ostringstream ss;
-    ss << f.rdbuf();
-    return ss.str();
-}
+namespace {
 
 bool isRoot() {
     return geteuid() == 0;
 }
 
-std::optional<Slot> detectActiveSlotFromCmdline(const std::string& cmdline) {
-    // Expected patterns:
-    // root=PARTLABEL=rootfsA
-    // root=PARTLABEL=rootfsB
-    if (cmdline.find("root=PARTLABEL=rootfsA") != std::string::npos) return Slot::A;
-    if (cmdline.find("root=PARTLABEL=rootfsB") != std::string::npos) return Slot::B;
-
-    // Some systems might use root=LABEL= or root=/dev/...
-        // QEMU / virtio fallback
-    if (cmdline.find("root=/dev/vda2") != std::string::npos) return Slot::A;
-    if (cmdline.find("root=/dev/vda3") != std::string::npos) return Slot::B;
-    return std::nullopt;
-}
-
-Plan buildPlan(Slot active) {
-    Plan p{};
-    p.active = active;
-    p.target = (active == Slot::A) ? Slot::B : Slot::A;
-
-    if (p.target == Slot::A) {
-        p.targetDev = kDevA;
-        p.targetLabel = kLabelA;
-    } else {
-        p.targetDev = kDevB;
-        p.targetLabel = kLabelB;
-    }
-    return p;
-}
-
 uint64_t fileSizeBytes(const std::string& path) {
     struct stat st{};
     if (stat(path.c_str(), &st) != 0) {
@@ -96,20 +52,6 @@ uint64_t fileSizeBytes(const std::string& path) {
     return static_cast<uint64_t>(st.st_size);
 }
 
-uint64_t blockDeviceSizeBytes(const std::string& devPath) {
-    int fd = open(devPath.c_str(), O_RDONLY | O_CLOEXEC);
-    if (fd < 0) {
-        throw std::runtime_error("Failed to open block device " + devPath + ": " + std::strerror(errno));
-    }
-    uint64_t bytes = 0;
-    if (ioctl(fd, BLKGETSIZE64, &bytes) != 0) {
-        close(fd);
-        throw std::runtime_error("ioctl(BLKGETSIZE64) failed for " + devPath + ": " + std::strerror(errno));
-    }
-    close(fd);
-    return bytes;
-}
-
 void fsyncFile(const std::string& path) {
     int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
     if (fd < 0) return;
@@ -117,129 +59,731 @@ void fsyncFile(const std::string& path) {
     close(fd);
 }
 
-void atomicWriteFile(const std::string& path, const std::string& content) {
-    // Write to temp file in same directory then rename()
-    std::string tmp = path + ".tmp";
-    int fd = open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
-    if (fd < 0) {
-        throw std::runtime_error("Failed to open temp file " + tmp + ": " + std::strerror(errno));
-    }
-
-    ssize_t total = 0;
-    const char* buf = content.data();
-    ssize_t len = static_cast<ssize_t>(content.size());
-    while (total < len) {
-        ssize_t n = write(fd, buf + total, len - total);
-        if (n < 0) {
-            close(fd);
-            throw std::runtime_error("Write failed to " + tmp + ": " + std::strerror(errno));
+// Comparison unit of --skip-unchanged: small enough that a changed file
+// only costs the blocks around it, large enough that the writes left over
+// are still long and sequential
+constexpr size_t kCompareBlock = 64 * 1024;
+
+// O_DIRECT offset/length/address alignment; covers 512 B and 4 KiB sector devices
+constexpr size_t kAlign = 4096;
+
+// Largest hole of the image handed to the writer at once
+constexpr size_t kMaxHole = 256 * 1024 * 1024;
+
+// Scratch buffer for checking discarded ranges and writing zeros
+constexpr size_t kZeroChunk = 1024 * 1024;
+
+// Every x86-64 CPU has SSE2 and every AArch64 one NEON, so no runtime
+// dispatch: 64 bytes are OR-ed per step, stopping at the first non-zero.
+bool isZero(const char* p, size_t size) {
+    size_t i = 0;
+#if defined(__SSE2__)
+    for (; i + 64 <= size; i += 64) {
+        const __m128i* q = reinterpret_cast<const __m128i*>(p + i);
+        const __m128i v = _mm_or_si128(_mm_or_si128(_mm_loadu_si128(q), _mm_loadu_si128(q + 1)),
+                                       _mm_or_si128(_mm_loadu_si128(q + 2), _mm_loadu_si128(q + 3)));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_setzero_si128())) != 0xFFFF) return false;
+    }
+#elif defined(__ARM_NEON)
+    for (; i + 64 <= size; i += 64) {
+        const uint8_t* q = reinterpret_cast<const uint8_t*>(p + i);
+        const uint64x2_t v = vreinterpretq_u64_u8(vorrq_u8(vorrq_u8(vld1q_u8(q), vld1q_u8(q + 16)), vorrq_u8(vld1q_u8(q + 32), vld1q_u8(q + 48))));
+        if ((vgetq_lane_u64(v, 0) | vgetq_lane_u64(v, 1)) != 0) return false;
+    }
+#endif
+    for (; i < size; ++i) {
+        if (p[i] != 0) return false;
+    }
+    return true;
+}
+
+// Whether the image holds data at `offset`, and where that data or hole
+// ends. Without SEEK_HOLE support everything counts as data.
+bool dataAt(int fd, uint64_t offset, uint64_t size, uint64_t& end) {
+    end = size;
+#if defined(SEEK_DATA) && defined(SEEK_HOLE)
+    const off_t data = lseek(fd, static_cast<off_t>(offset), SEEK_DATA);
+    if (data < 0) return errno != ENXIO;  // ENXIO: only a hole is left
+    if (static_cast<uint64_t>(data) > offset) {
+        end = std::min(size, static_cast<uint64_t>(data));
+        return false;
+    }
+    const off_t hole = lseek(fd, static_cast<off_t>(offset), SEEK_HOLE);
+    if (hole >= 0) end = std::min(size, static_cast<uint64_t>(hole));
+#else
+    (void)fd;
+    (void)offset;
+#endif
+    return true;
+}
+
+void preadFully(int fd, char* data, size_t size, uint64_t offset, size_t& got) {
+    got = 0;
+    while (got < size) {
+        ssize_t r = pread(fd, data + got, size - got, static_cast<off_t>(offset + got));
+        if (r < 0 && errno == EINTR) continue;
+        if (r < 0) throw std::runtime_error("Read of target failed: " + std::string(std::strerror(errno)));
+        if (r == 0) break;
+        got += static_cast<size_t>(r);
+    }
+}
+
+// False with errno set on failure
+bool pwriteAll(int fd, const char* data, size_t size, uint64_t offset) {
+    while (size > 0) {
+        ssize_t w = pwrite(fd, data, size, static_cast<off_t>(offset));
+        if (w < 0 && errno == EINTR) continue;
+        if (w < 0) return false;
+        data += w;
+        size -= static_cast<size_t>(w);
+        offset += static_cast<uint64_t>(w);
+    }
+    return true;
+}
+
+[[noreturn]] void throwWriteError() {
+    throw std::runtime_error("Write to block device failed: " + std::string(std::strerror(errno)));
+}
+
+struct FreeDeleter {
+    void operator()(char* p) const { std::free(p); }
+};
+typedef std::unique_ptr<char, FreeDeleter> AlignedBuffer;
+
+AlignedBuffer allocateAligned(size_t size) {
+    void* p = nullptr;
+    if (posix_memalign(&p, kAlign, size) != 0) throw std::bad_alloc();
+    return AlignedBuffer(static_cast<char*>(p));
+}
+
+struct WriteStats {
+    uint64_t imageBytes = 0;
+    uint64_t writtenBytes = 0;  // what actually went to the target
+    double readSeconds = 0;     // reader thread, in read()
+    double writeSeconds = 0;    // writer, in the target's pread/pwrite
+    double elapsedSeconds = 0;
+
+    std::string imageSha256;     // of the image as read
+    std::string targetSha256;    // of the target read back, empty without verify
+    double verifyTailSeconds = 0;  // read-back still running after the last write
+
+    uint64_t zeroBytes = 0;       // zeroed on the target instead of written
+    uint64_t discardedBytes = 0;  // part of zeroBytes the target discarded
+    uint64_t holeBytes = 0;       // holes of the image, never read
+};
+
+struct WriteOptions {
+    bool skipUnchanged = false;
+    unsigned depth = 4;                  // buffers in flight between the reader and the writer
+    size_t bufferSize = 4 * 1024 * 1024;  // rounded up to kAlign
+    std::string backend = "pwrite";      // pwrite, writeback, direct or auto
+    bool verify = true;                  // read the target back and hash it
+    bool sparse = false;                 // zero runs and holes are zeroed on the target, not written
+};
+
+// The partition being written. Same backends as the client's ImageWriter:
+//  - pwrite: through the page cache, flushed by the fsync at the end;
+//  - writeback: through the page cache, but each buffer's writeback is
+//    started right away and the previous one is waited for and dropped
+//    from the cache, so dirty pages stay bounded to about two buffers
+//    instead of piling up to gigabytes for the final fsync;
+//  - direct: O_DIRECT from aligned buffers, bypassing the cache; anything
+//    unaligned (the image's tail) goes through the cache. Falls back to
+//    writeback if the device refuses O_DIRECT.
+//  - auto: direct where possible, else writeback.
+//
+// zero() clears a range without writing it where the target allows.
+class Target {
+   public:
+    Target(const std::string& devPath, const std::string& backend, bool readable) {
+        if (backend != "pwrite" && backend != "writeback" && backend != "direct" && backend != "auto") {
+            throw std::runtime_error("Unknown write backend: " + backend);
+        }
+        fd_ = open(devPath.c_str(), (readable ? O_RDWR : O_WRONLY) | O_CLOEXEC);
+        if (fd_ < 0) {
+            throw std::runtime_error("Failed to open target device " + devPath + ": " + std::strerror(errno));
         }
-        total += n;
+        writeback_ = backend != "pwrite";
+
+        struct stat st{};
+        blockDevice_ = fstat(fd_, &st) == 0 && S_ISBLK(st.st_mode);
+
+#if defined(O_DIRECT)
+        if (backend == "direct" || backend == "auto") {
+            directFd_ = open(devPath.c_str(), O_WRONLY | O_DIRECT | O_CLOEXEC);
+            if (directFd_ < 0) std::cerr << "O_DIRECT unavailable (" << std::strerror(errno) << "), using writeback\n";
+        }
+#else
+        if (backend == "direct") std::cerr << "O_DIRECT not supported here, using writeback\n";
+#endif
     }
 
-    if (fsync(fd) != 0) {
-        close(fd);
-        throw std::runtime_error("fsync failed for " + tmp + ": " + std::strerror(errno));
+    ~Target() {
+        if (directFd_ >= 0) close(directFd_);
+        close(fd_);
+    }
+
+    Target(const Target&) = delete;
+    Target& operator=(const Target&) = delete;
+
+    const char* backendName() const { return directFd_ >= 0 ? "direct" : writeback_ ? "writeback" : "pwrite"; }
+
+    void write(const char* data, size_t size, uint64_t offset) {
+        if (directFd_ >= 0 && offset % kAlign == 0 && reinterpret_cast<uintptr_t>(data) % kAlign == 0) {
+            const size_t body = size - size % kAlign;
+            if (body == 0 || pwriteAll(directFd_, data, body, offset)) {
+                if (body < size && !pwriteAll(fd_, data + body, size - body, offset + body)) throwWriteError();
+                return;
+            }
+            if (errno != EINVAL) throwWriteError();
+
+            // The open succeeded but the device or filesystem rejects the I/O
+            std::cerr << "O_DIRECT write rejected, switching to writeback\n";
+            close(directFd_);
+            directFd_ = -1;
+        }
+
+        if (!pwriteAll(fd_, data, size, offset)) throwWriteError();
+        if (writeback_) startWriteback(offset, size);
+    }
+
+    // Reads what the target holds at `offset`; `got` stops short at its end
+    void read(char* data, size_t size, uint64_t offset, size_t& got) {
+        preadFully(fd_, data, size, offset, got);
+        // Only needed for the comparison, not worth keeping cached
+        if (writeback_) posix_fadvise(fd_, static_cast<off_t>(offset), static_cast<off_t>(size), POSIX_FADV_DONTNEED);
+    }
+
+    // Makes [offset, offset + size) read as zeros; both are multiples of
+    // kAlign. A block device gets BLKDISCARD, which costs the flash no
+    // writes, but not every card reads zeros afterwards, so the range is
+    // read back to check. Once that fails, or where discard is not
+    // supported, BLKZEROOUT lets the device zero it. A regular file gets a
+    // hole punched. Zeros are written where none of that works.
+    enum class Zeroed { Discarded, Cleared, Written };
+    Zeroed zero(uint64_t offset, size_t size) {
+#if defined(__linux__)
+        uint64_t range[2] = {offset, size};
+        if (blockDevice_) {
+            if (discard_) {
+                if (ioctl(fd_, BLKDISCARD, range) == 0 && readsZero(offset, size)) return Zeroed::Discarded;
+                std::cerr << "Discard " << (errno ? std::strerror(errno) : "left data behind") << ", zeroing instead\n";
+                discard_ = false;
+            }
+            if (ioctl(fd_, BLKZEROOUT, range) == 0) return Zeroed::Cleared;
+        } else {
+            // A stand-in file is extended first: the hole may lie past its end
+            struct stat st{};
+            if (fstat(fd_, &st) == 0 && static_cast<uint64_t>(st.st_size) < offset + size &&
+                ftruncate(fd_, static_cast<off_t>(offset + size)) != 0) {
+                throwWriteError();
+            }
+            if (fallocate(fd_, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, static_cast<off_t>(offset), static_cast<off_t>(size)) == 0) {
+                return Zeroed::Cleared;
+            }
+        }
+#endif
+        char* zeros = scratch();
+        std::memset(zeros, 0, kZeroChunk);
+        for (uint64_t done = 0; done < size; done += kZeroChunk) {
+            write(zeros, static_cast<size_t>(std::min<uint64_t>(kZeroChunk, size - done)), offset + done);
+        }
+        return Zeroed::Written;
+    }
+
+    // Waits for the outstanding writeback and makes everything durable
+    void finish() {
+        finishWriteback();
+        if (fsync(fd_) != 0) {
+            throw std::runtime_error("fsync(target) failed: " + std::string(std::strerror(errno)));
+        }
+    }
+
+   private:
+    char* scratch() {
+        if (!scratch_) scratch_ = allocateAligned(kZeroChunk);
+        return scratch_.get();
+    }
+
+    // errno is 0 if the range could be read but holds data
+    bool readsZero(uint64_t offset, size_t size) {
+        char* buf = scratch();
+        for (uint64_t done = 0; done < size; done += kZeroChunk) {
+            const size_t want = static_cast<size_t>(std::min<uint64_t>(kZeroChunk, size - done));
+            size_t got = 0;
+            preadFully(fd_, buf, want, offset + done, got);
+            posix_fadvise(fd_, static_cast<off_t>(offset + done), static_cast<off_t>(want), POSIX_FADV_DONTNEED);
+            if (got < want || !isZero(buf, want)) {
+                errno = 0;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Starts writing this range now, then waits for the previous one and
+    // drops its pages
+    void startWriteback(uint64_t offset, size_t size) {
+#if defined(__linux__)
+        sync_file_range(fd_, static_cast<off_t>(offset), static_cast<off_t>(size), SYNC_FILE_RANGE_WRITE);
+#endif
+        finishWriteback();
+        pendingOffset_ = offset;
+        pendingSize_ = size;
+    }
+
+    void finishWriteback() {
+        if (pendingSize_ == 0) return;
+#if defined(__linux__)
+        sync_file_range(fd_, static_cast<off_t>(pendingOffset_), static_cast<off_t>(pendingSize_),
+                        SYNC_FILE_RANGE_WAIT_BEFORE | SYNC_FILE_RANGE_WRITE | SYNC_FILE_RANGE_WAIT_AFTER);
+#endif
+        posix_fadvise(fd_, static_cast<off_t>(pendingOffset_), static_cast<off_t>(pendingSize_), POSIX_FADV_DONTNEED);
+        pendingSize_ = 0;
+    }
+
+    int fd_ = -1;
+    int directFd_ = -1;
+    bool writeback_ = false;
+    uint64_t pendingOffset_ = 0;
+    size_t pendingSize_ = 0;
+    bool blockDevice_ = false;
+    bool discard_ = true;  // until the device refuses it or leaves data behind
+    AlignedBuffer scratch_;
+};
+
+// Reads the written range of the target back and hashes it. O_DIRECT keeps
+// the page cache out of the way, so what is hashed is what the device
+// returns; where O_DIRECT is refused, each range is flushed and dropped
+// from the cache before it is read instead.
+class ReadBack {
+   public:
+    ReadBack(const std::string& devPath, size_t bufferSize) : buffer_(allocateAligned(bufferSize)), bufferSize_(bufferSize), path_(devPath) {
+#if defined(O_DIRECT)
+        fd_ = open(devPath.c_str(), O_RDONLY | O_DIRECT | O_CLOEXEC);
+        direct_ = fd_ >= 0;
+#endif
+        if (fd_ < 0) fd_ = open(devPath.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd_ < 0) {
+            throw std::runtime_error("Failed to open " + devPath + " for read-back: " + std::strerror(errno));
+        }
     }
-    close(fd);
 
-    if (rename(tmp.c_str(), path.c_str()) != 0) {
-        throw std::runtime_error("rename(" + tmp + " -> " + path + ") failed: " + std::strerror(errno));
+    ~ReadBack() { close(fd_); }
+
+    ReadBack(const ReadBack&) = delete;
+    ReadBack& operator=(const ReadBack&) = delete;
+
+    // Hashes the target from where the last call stopped up to `end`. Ends
+    // of earlier calls are multiples of the buffer size, so every O_DIRECT
+    // read starts aligned.
+    void hashUpTo(uint64_t end) {
+        while (hashed_ < end) {
+            const size_t want = static_cast<size_t>(std::min<uint64_t>(bufferSize_, end - hashed_));
+            size_t got = 0;
+            readAt(want, got);
+            if (got < want) throw std::runtime_error("Read-back of " + path_ + " ended early at " + std::to_string(hashed_ + got));
+            sha_.update(reinterpret_cast<const uint8_t*>(buffer_.get()), want);
+            hashed_ += want;
+        }
     }
 
-    // Best effort to fsync directory entry
-    auto slash = path.find_last_of('/');
-    if (slash != std::string::npos) {
-        std::string dir = path.substr(0, slash);
-        int dfd = open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
-        if (dfd >= 0) {
-            fsync(dfd);
-            close(dfd);
+    std::string hexDigest() { return sha_.hexDigest(); }
+
+   private:
+    void readAt(size_t want, size_t& got) {
+        if (direct_) {
+            // The device is read in whole sectors; only `want` bytes are used
+            const size_t len = (want + kAlign - 1) / kAlign * kAlign;
+            ssize_t r = 0;
+            do {
+                r = pread(fd_, buffer_.get(), len, static_cast<off_t>(hashed_));
+            } while (r < 0 && errno == EINTR);
+            if (r >= 0) {
+                // A regular-file stand-in may end where the image ends
+                got = std::min(want, static_cast<size_t>(r));
+                return;
+            }
+            if (errno != EINVAL) throw std::runtime_error("Read-back failed: " + std::string(std::strerror(errno)));
+
+            std::cerr << "O_DIRECT read-back rejected, flushing and dropping the cache instead\n";
+            close(fd_);
+            direct_ = false;
+            fd_ = open(path_.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd_ < 0) throw std::runtime_error("Failed to reopen " + path_ + " for read-back: " + std::strerror(errno));
         }
+
+        // Dirty pages cannot be dropped, so they are written out first
+#if defined(__linux__)
+        sync_file_range(fd_, static_cast<off_t>(hashed_), static_cast<off_t>(want),
+                        SYNC_FILE_RANGE_WAIT_BEFORE | SYNC_FILE_RANGE_WRITE | SYNC_FILE_RANGE_WAIT_AFTER);
+#endif
+        posix_fadvise(fd_, static_cast<off_t>(hashed_), static_cast<off_t>(want), POSIX_FADV_DONTNEED);
+        preadFully(fd_, buffer_.get(), want, hashed_, got);
     }
+
+    int fd_ = -1;
+    bool direct_ = false;
+    AlignedBuffer buffer_;
+    size_t bufferSize_;
+    std::string path_;
+    uint64_t hashed_ = 0;
+    Sha256 sha_;
+};
+
+// Hand-off of buffer indices between the reader and the writer thread. The
+// fixed set of buffers circulating through two of these bounds the memory;
+// close() ends the waits on both sides.
+class Channel {
+   public:
+    void push(size_t v) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        items_.push_back(v);
+        cv_.notify_one();
+    }
+
+    // False once the channel is closed and drained
+    bool pop(size_t& v) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [&] { return closed_ || !items_.empty(); });
+        if (items_.empty()) return false;
+        v = items_.front();
+        items_.pop_front();
+        return true;
+    }
+
+    void close() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+        cv_.notify_all();
+    }
+
+   private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<size_t> items_;
+    bool closed_ = false;
+};
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
 }
 
-std::string updateExtlinuxRootPartlabel(const std::string& extlinux, const std::string& newLabel) {
-    // Replace only "root=PARTLABEL=rootfsA" or "root=PARTLABEL=rootfsB"
-    // Keep everything else the same.
-    std::string out = extlinux;
+// Writes (or with skipUnchanged, compares and patches) one image block at `pos`
+void writeRun(Target& out, const char* data, size_t n, uint64_t pos, bool skipUnchanged, char* current, WriteStats& stats) {
+    if (!skipUnchanged) {
+        out.write(data, n, pos);
+        stats.writtenBytes += n;
+        return;
+    }
 
-    const std::string a = "root=PARTLABEL=rootfsA";
-    const std::string b = "root=PARTLABEL=rootfsB";
-    size_t posA = out.find(a);
-    size_t posB = out.find(b);
+    // Past a short read of the target everything counts as changed
+    size_t have = 0;
+    out.read(current, n, pos, have);
+
+    // Differing blocks next to each other go out as one write
+    size_t runStart = 0;
+    size_t runEnd = 0;
+    auto flushRun = [&]() {
+        if (runEnd == runStart) return;
+        out.write(data + runStart, runEnd - runStart, pos + runStart);
+        stats.writtenBytes += runEnd - runStart;
+    };
+    // memcmp is vectorized in glibc and stops at the first difference;
+    // both sides are in memory already, so hashing them would only cost more
+    for (size_t b = 0; b < n; b += kCompareBlock) {
+        const size_t len = std::min(kCompareBlock, n - b);
+        if (b + len <= have && std::memcmp(data + b, current + b, len) == 0) continue;
+        if (runEnd != b) {
+            flushRun();
+            runStart = b;
+        }
+        runEnd = b + len;
+    }
+    flushRun();
+}
 
-    if (posA == std::string::npos && posB == std::string::npos) {
-        throw std::runtime_error("extlinux.conf does not contain root=PARTLABEL=rootfsA/B");
+void zeroRun(Target& out, uint64_t pos, size_t n, WriteStats& stats) {
+    switch (out.zero(pos, n)) {
+        case Target::Zeroed::Discarded:
+            stats.discardedBytes += n;
+            stats.zeroBytes += n;
+            break;
+        case Target::Zeroed::Cleared:
+            stats.zeroBytes += n;
+            break;
+        case Target::Zeroed::Written:
+            stats.writtenBytes += n;
+            break;
     }
+}
 
-    const std::string repl = "root=PARTLABEL=" + newLabel;
+// With sparse, the all-zero kCompareBlocks of a buffer are zeroed on the
+// target and the rest is written; neighbours of the same kind are merged.
+// An unaligned tail is always written.
+void applyBlock(Target& out, const char* data, size_t n, uint64_t pos, const WriteOptions& options, char* current, WriteStats& stats) {
+    if (!options.sparse) {
+        writeRun(out, data, n, pos, options.skipUnchanged, current, stats);
+        return;
+    }
 
-    if (posA != std::string::npos) out.replace(posA, a.size(), repl);
-    if (posB != std::string::npos) out.replace(posB, b.size(), repl);
-    return out;
+    size_t runStart = 0;
+    bool runZero = false;
+    auto flushRun = [&](size_t end) {
+        if (end == runStart) return;
+        if (runZero) zeroRun(out, pos + runStart, end - runStart, stats);
+        else writeRun(out, data + runStart, end - runStart, pos + runStart, options.skipUnchanged, current, stats);
+        runStart = end;
+    };
+    for (size_t b = 0; b < n; b += kCompareBlock) {
+        const size_t len = std::min(kCompareBlock, n - b);
+        const bool zero = len % kAlign == 0 && isZero(data + b, len);
+        if (zero != runZero) {
+            flushRun(b);
+            runZero = zero;
+        }
+    }
+    flushRun(n);
 }
 
-void streamWriteImageToBlock(const std::string& imagePath, const std::string& devPath) {
+// A reader thread fills `depth` buffers from the image while this thread
+// writes the ones already read, so the source and the target are busy at
+// the same time and the copy takes about as long as the slower of the two
+// rather than their sum.
+//
+// With skipUnchanged every kCompareBlock of the target is read first and
+// only the blocks that differ from the image are written, coalesced into
+// runs. When the inactive slot still holds the previous release most of it
+// matches, and a read costs the flash far less time and no wear.
+//
+// With verify a third thread reads the target back behind the writer and
+// hashes it, while the reader hashes the image on its way in. The read-back
+// only ever covers blocks already written, so at the end just the last few
+// are left and the check adds little to the write.
+//
+// With sparse, holes of the image (SEEK_HOLE) are not read at all and zero
+// blocks in its data are found by a vector scan; both are zeroed on the
+// target instead of written, see Target::zero().
+WriteStats streamWriteImageToBlock(const std::string& imagePath, const std::string& devPath, const WriteOptions& options) {
+    const size_t bufferSize = std::max(kAlign, (options.bufferSize + kAlign - 1) / kAlign * kAlign);
+
     int in = open(imagePath.c_str(), O_RDONLY | O_CLOEXEC);
     if (in < 0) {
         throw std::runtime_error("Failed to open image " + imagePath + ": " + std::strerror(errno));
     }
+    struct stat imageStat{};
+    const uint64_t imageSize = fstat(in, &imageStat) == 0 ? static_cast<uint64_t>(imageStat.st_size) : 0;
 
-    int out = open(devPath.c_str(), O_WRONLY | O_CLOEXEC);
-    if (out < 0) {
+    std::unique_ptr<Target> out;
+    try {
+        out.reset(new Target(devPath, options.backend, options.skipUnchanged || options.sparse));
+    } catch (...) {
         close(in);
-        throw std::runtime_error("Failed to open target device " + devPath + ": " + std::strerror(errno));
+        throw;
     }
-
-    constexpr size_t kBuf = 4 * 1024 * 1024;
-    std::string buffer;
-    buffer.resize(kBuf);
-
-    uint64_t written = 0;
-    while (true) {
-        ssize_t r = read(in, buffer.data(), buffer.size());
-        if (r == 0) break;
-        if (r < 0) {
-            close(in); close(out);
-            throw std::runtime_error("Read failed: " + std::string(std::strerror(errno)));
-        }
-
-        ssize_t off = 0;
-        while (off < r) {
-            ssize_t w = write(out, buffer.data() + off, r - off);
-            if (w < 0) {
-                close(in); close(out);
-                throw std::runtime_error("Write to block device failed: " + std::string(std::strerror(errno)));
+    std::cerr << "Target backend: " << out->backendName() << ", " << (bufferSize / 1024) << " KiB buffers, depth "
+              << std::max(options.depth, 1u) << "\n";
+
+    // Outside pwrite mode the image's pages are dropped once read as well
+    const bool dropImagePages = options.backend != "pwrite";
+    if (dropImagePages) posix_fadvise(in, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    // Aligned, so full blocks can go straight out with O_DIRECT
+    struct Block {
+        AlignedBuffer data;
+        size_t size = 0;
+        uint64_t offset = 0;
+        bool hole = false;  // zeros not read from the image; data unused
+    };
+    std::vector<Block> blocks(std::max(options.depth, 1u));
+    Channel freeBlocks;
+    Channel fullBlocks;
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        blocks[i].data = allocateAligned(bufferSize);
+        freeBlocks.push(i);
+    }
+    AlignedBuffer current;
+    if (options.skipUnchanged) current = allocateAligned(bufferSize);
+
+    WriteStats stats;
+    const auto start = std::chrono::steady_clock::now();
+
+    // How far the writer got; blocks are written in order
+    struct {
+        std::mutex mutex;
+        std::condition_variable cv;
+        uint64_t written = 0;
+        bool done = false;  // everything written and flushed
+        bool abort = false;
+    } progress;
+    auto advance = [&](uint64_t written, bool done, bool abort) {
+        std::lock_guard<std::mutex> lock(progress.mutex);
+        progress.written = written;
+        progress.done = done;
+        progress.abort = abort;
+        progress.cv.notify_one();
+    };
+
+    // Blocks are filled completely except the last, so their offsets stay
+    // aligned. With sparse a block also ends at the next hole, rounded up to
+    // kAlign, and the hole, rounded down, is passed on as a block of its own.
+    std::exception_ptr readError;
+    std::thread reader([&] {
+        try {
+            uint64_t offset = 0;
+            uint64_t extentEnd = 0;
+            bool inData = true;
+            size_t i = 0;
+            bool eof = false;
+            Sha256 imageSha;
+            std::vector<uint8_t> zeros;
+            while (!eof && freeBlocks.pop(i)) {
+                Block& b = blocks[i];
+                const auto t = std::chrono::steady_clock::now();
+                b.size = 0;
+                b.hole = false;
+                size_t limit = bufferSize;
+                if (options.sparse && offset < imageSize) {
+                    if (offset >= extentEnd) inData = dataAt(in, offset, imageSize, extentEnd);
+                    const uint64_t holeEnd = extentEnd / kAlign * kAlign;
+                    if (!inData && holeEnd > offset) {
+                        b.hole = true;
+                        b.size = static_cast<size_t>(std::min<uint64_t>(kMaxHole, holeEnd - offset));
+                    } else {
+                        limit = static_cast<size_t>(std::min<uint64_t>(bufferSize, (extentEnd + kAlign - 1) / kAlign * kAlign - offset));
+                    }
+                }
+                while (!b.hole && b.size < limit) {
+                    ssize_t r = pread(in, b.data.get() + b.size, limit - b.size, static_cast<off_t>(offset + b.size));
+                    if (r < 0 && errno == EINTR) continue;
+                    if (r < 0) throw std::runtime_error("Read failed: " + std::string(std::strerror(errno)));
+                    if (r == 0) {
+                        eof = true;
+                        break;
+                    }
+                    b.size += static_cast<size_t>(r);
+                }
+                if (b.hole && options.verify) {
+                    zeros.resize(kZeroChunk);
+                    for (size_t done = 0; done < b.size; done += kZeroChunk) imageSha.update(zeros.data(), std::min(kZeroChunk, b.size - done));
+                } else if (options.verify) {
+                    imageSha.update(reinterpret_cast<const uint8_t*>(b.data.get()), b.size);
+                }
+                if (dropImagePages) posix_fadvise(in, static_cast<off_t>(offset), static_cast<off_t>(b.size), POSIX_FADV_DONTNEED);
+                stats.readSeconds += secondsSince(t);
+                b.offset = offset;
+                offset += b.size;
+                if (b.size > 0) fullBlocks.push(i);
             }
-            off += w;
-            written += static_cast<uint64_t>(w);
-        }
-
-        // Minimal progress
-        if ((written % (256ULL * 1024 * 1024)) < kBuf) {
-            std::cerr << "Written " << (written / (1024 * 1024)) << " MiB...\n";
+            if (eof && options.verify) stats.imageSha256 = imageSha.hexDigest();
+        } catch (...) {
+            readError = std::current_exception();
         }
+        fullBlocks.close();
+    });
+
+    std::exception_ptr verifyError;
+    std::thread verifier;
+    if (options.verify) {
+        verifier = std::thread([&] {
+            try {
+                ReadBack back(devPath, bufferSize);
+                uint64_t upTo = 0;
+                bool last = false;
+                while (!last) {
+                    {
+                        std::unique_lock<std::mutex> lock(progress.mutex);
+                        progress.cv.wait(lock, [&] { return progress.abort || progress.done || progress.written > upTo; });
+                        if (progress.abort) return;
+                        upTo = progress.written;
+                        last = progress.done;
+                    }
+                    back.hashUpTo(upTo);
+                }
+                stats.targetSha256 = back.hexDigest();
+            } catch (...) {
+                verifyError = std::current_exception();
+            }
+        });
     }
 
-    if (fsync(out) != 0) {
-        close(in); close(out);
-        throw std::runtime_error("fsync(target) failed: " + std::string(std::strerror(errno)));
+    try {
+        const uint64_t reportEvery = 256ULL * 1024 * 1024;
+        uint64_t nextReport = reportEvery;
+        size_t i = 0;
+        while (fullBlocks.pop(i)) {
+            Block& b = blocks[i];
+            const auto t = std::chrono::steady_clock::now();
+            if (b.hole) {
+                zeroRun(*out, b.offset, b.size, stats);
+                stats.holeBytes += b.size;
+            } else {
+                applyBlock(*out, b.data.get(), b.size, b.offset, options, current.get(), stats);
+            }
+            stats.writeSeconds += secondsSince(t);
+            stats.imageBytes += b.size;
+            freeBlocks.push(i);
+            if (options.verify) advance(stats.imageBytes, false, false);
+
+            // Minimal progress
+            if (stats.imageBytes >= nextReport) {
+                std::cerr << (options.skipUnchanged || options.sparse ? "Processed " : "Written ") << (stats.imageBytes / (1024 * 1024)) << " MiB...\n";
+                nextReport = (stats.imageBytes / reportEvery + 1) * reportEvery;
+            }
+        }
+        if (readError) std::rethrow_exception(readError);
+
+        const auto t = std::chrono::steady_clock::now();
+        out->finish();
+        stats.writeSeconds += secondsSince(t);
+    } catch (...) {
+        freeBlocks.close();
+        reader.join();
+        advance(0, false, true);
+        if (verifier.joinable()) verifier.join();
+        close(in);
+        throw;
     }
 
+    reader.join();
     close(in);
-    close(out);
+    out.reset();
 
     // Ensure kernel flushes everything
     sync();
+    stats.elapsedSeconds = secondsSince(start);
+
+    if (verifier.joinable()) {
+        const auto t = std::chrono::steady_clock::now();
+        advance(stats.imageBytes, true, false);
+        verifier.join();
+        if (verifyError) std::rethrow_exception(verifyError);
+        stats.verifyTailSeconds = secondsSince(t);
+    }
+    return stats;
 }
 
 struct Args {
     std::string image;
     std::string bootconf = "/boot/extlinux/extlinux.conf";
     bool dryRun = false;
+    WriteOptions write;
 };
 
+uint64_t parseNumber(const std::string& opt, const std::string& value, uint64_t min) {
+    size_t used = 0;
+    unsigned long long v = 0;
+    try {
+        v = std::stoull(value, &used);
+    } catch (const std::exception&) {
+        used = 0;
+    }
+    if (used != value.size() || value.empty() || value[0] == '-' || v < min) {
+        throw std::runtime_error("Invalid value for " + opt + ": " + value);
+    }
+    return v;
+}
+
 Args parseArgs(int argc, char** argv) {
     Args a{};
     for (int i = 1; i < argc; ++i) {
@@ -252,9 +796,23 @@ Args parseArgs(int argc, char** argv) {
         if (k == "--image") a.image = needValue(k);
         else if (k == "--bootconf") a.bootconf = needValue(k);
         else if (k == "--dry-run") a.dryRun = true;
+        else if (k == "--skip-unchanged") a.write.skipUnchanged = true;
+        else if (k == "--depth") a.write.depth = static_cast<unsigned>(parseNumber(k, needValue(k), 1));
+        else if (k == "--buffer-size") a.write.bufferSize = static_cast<size_t>(parseNumber(k, needValue(k), 1));
+        else if (k == "--write-backend") a.write.backend = needValue(k);
+        else if (k == "--no-verify") a.write.verify = false;
+        else if (k == "--sparse") a.write.sparse = true;
         else if (k == "-h" || k == "--help") {
             std::cout <<
-                "Usage: ota-apply --image <rootfs.ext4> [--bootconf <path>] [--dry-run]\n";
+                "Usage: ota-apply --image <rootfs.ext4> [--bootconf <path>] [--skip-unchanged] [--sparse] [--depth <n>]\n"
+                "                 [--buffer-size <bytes>] [--write-backend pwrite|writeback|direct|auto] [--no-verify] [--dry-run]\n"
+                "  --skip-unchanged       read the target first and only write the blocks that differ\n"
+                "  --sparse               discard or zero the target where the image has holes or zero blocks\n"
+                "  --depth <n>            buffers in flight between image reads and target writes (default 4)\n"
+                "  --buffer-size <bytes>  size of each buffer, rounded up to 4 KiB (default 4194304)\n"
+                "  --write-backend <b>    pwrite: page cache, flushed at the end (default); writeback: page cache with\n"
+                "                         bounded dirty data; direct: O_DIRECT, else writeback; auto: same as direct\n"
+                "  --no-verify            skip reading the target back and comparing it with the image\n";
             std::exit(0);
         } else {
             throw std::runtime_error("Unknown argument: " + k);
@@ -278,14 +836,14 @@ int main(int argc, char** argv) {
 
         // 1) Determine active slot
         std::string cmdline = readTextFile("/proc/cmdline");
-        auto activeOpt = detectActiveSlotFromCmdline(cmdline);
-        if (!activeOpt) {
+        Slot active;
+        if (!detectActiveSlotFromCmdline(cmdline, active)) {
             std::cerr << "ERROR: Cannot determine active slot from /proc/cmdline\n";
             return 20;
         }
-        Plan plan = buildPlan(*activeOpt);
+        Plan plan = buildPlan(active);
 
-        std::cerr << "Active slot: " << ((*activeOpt == Slot::A) ? "A" : "B")
+        std::cerr << "Active slot: " << ((active == Slot::A) ? "A" : "B")
                   << "  Target slot: " << ((plan.target == Slot::A) ? "A" : "B") << "\n";
         std::cerr << "Target device: " << plan.targetDev
                   << "  Target label: " << plan.targetLabel << "\n";
@@ -313,9 +871,32 @@ int main(int argc, char** argv) {
         }
 
         // 4) Write image to inactive partition
-        std::cerr << "Writing image to " << plan.targetDev << "...\n";
-        streamWriteImageToBlock(args.image, plan.targetDev);
-        std::cerr << "Write complete.\n";
+        std::cerr << "Writing image to " << plan.targetDev << (args.write.skipUnchanged ? " (skipping unchanged blocks)" : "")
+                  << (args.write.sparse ? " (sparse)" : "") << "...\n";
+        WriteStats written = streamWriteImageToBlock(args.image, plan.targetDev, args.write);
+        std::cerr << "Write complete in " << written.elapsedSeconds << " s (reading " << written.readSeconds << " s, writing "
+                  << written.writeSeconds << " s, depth " << args.write.depth << ").\n";
+        if ((args.write.skipUnchanged || args.write.sparse) && written.imageBytes > 0) {
+            const uint64_t skipped = written.imageBytes - written.writtenBytes;
+            std::cerr << "Wrote " << (written.writtenBytes / (1024 * 1024)) << " of " << (written.imageBytes / (1024 * 1024)) << " MiB";
+            if (args.write.skipUnchanged) {
+                std::cerr << "; " << ((skipped - written.zeroBytes) / (1024 * 1024)) << " MiB already matched";
+            }
+            if (args.write.sparse) {
+                std::cerr << "; " << (written.zeroBytes / (1024 * 1024)) << " MiB of zeros skipped (" << (written.discardedBytes / (1024 * 1024))
+                          << " MiB discarded, " << (written.holeBytes / (1024 * 1024)) << " MiB never read from holes in the image)";
+            }
+            std::cerr << " (" << (100 * skipped / written.imageBytes) << "% fewer bytes written)\n";
+        }
+        if (args.write.verify) {
+            if (written.targetSha256 != written.imageSha256) {
+                std::cerr << "ERROR: Read-back of " << plan.targetDev << " does not match the image (sha256 "
+                          << written.targetSha256 << ", expected " << written.imageSha256 << "); boot config left unchanged.\n";
+                return 40;
+            }
+            std::cerr << "Read-back verified (sha256 " << written.imageSha256 << ", " << written.verifyTailSeconds
+                      << " s after the write).\n";
+        }
 
         // 5) Update extlinux.conf atomically (after successful write)
         std::cerr << "Updating boot config " << args.bootconf << "...\n";